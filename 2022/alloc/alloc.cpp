@@ -0,0 +1,209 @@
+#include "aoc_alloc.hpp"
+#include <new>
+#include <atomic>
+#include <array>
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+
+/*
+    Replacement of the global operator new / delete that keeps track of the
+    number of allocations, the number of bytes allocated and the peak live
+    heap. The size of every allocation is stored in front of the block, so
+    it is also known when the unsized operator delete is used.
+*/
+namespace{
+
+    //Room in front of every block, keeps the default alignment intact
+    constexpr size_t header_size = alignof(std::max_align_t);
+
+    struct Counters{
+        std::atomic<long long> allocations{0};
+        std::atomic<long long> frees{0};
+        std::atomic<long long> bytes{0};
+        std::atomic<long long> live{0};
+        std::atomic<long long> peak{0};
+    };
+
+    //The allocations made by the current thread. The phases are measured per
+    //thread, so the puzzles that run concurrently (aoc_all, --batch and
+    //aoc_served) do not mix up their statistics. Plain integers, so that no
+    //construction or destruction is needed inside operator new.
+    struct ThreadCounters{
+        long long allocations;
+        long long frees;
+        long long bytes;
+        long long live;         //Allocated minus freed by this thread
+        long long phase_peak;   //Peak of live within the current phase
+    };
+    thread_local ThreadCounters thread_counters{};
+
+    Counters& counters(){
+        //Never destroyed: allocations may happen during static destruction
+        static Counters* instance = new(std::malloc(sizeof(Counters))) Counters();
+        return *instance;
+    }
+
+    void update_max(std::atomic<long long>& max, long long value){
+        long long current = max.load(std::memory_order_relaxed);
+        while(value > current && !max.compare_exchange_weak(current,value,std::memory_order_relaxed)){}
+    }
+
+    void record_allocation(size_t size){
+        Counters& c = counters();
+        c.allocations.fetch_add(1,std::memory_order_relaxed);
+        c.bytes.fetch_add(size,std::memory_order_relaxed);
+        long long live = c.live.fetch_add(size,std::memory_order_relaxed) + size;
+        update_max(c.peak,live);
+        ThreadCounters& t = thread_counters;
+        t.allocations++;
+        t.bytes += size;
+        t.live  += size;
+        t.phase_peak = std::max(t.phase_peak,t.live);
+    }
+
+    void record_free(size_t size){
+        Counters& c = counters();
+        c.frees.fetch_add(1,std::memory_order_relaxed);
+        c.live.fetch_sub(size,std::memory_order_relaxed);
+        thread_counters.frees++;
+        thread_counters.live -= size;
+    }
+
+    //The size is stored right in front of the block
+    size_t& stored_size(void* ptr){
+        return *reinterpret_cast<size_t*>(static_cast<char*>(ptr) - sizeof(size_t));
+    }
+
+    void* allocate(size_t size){
+        void* base = std::malloc(size + header_size);
+        if(base == nullptr){
+            return nullptr;
+        }
+        void* ptr = static_cast<char*>(base) + header_size;
+        stored_size(ptr) = size;
+        record_allocation(size);
+        return ptr;
+    }
+
+    void deallocate(void* ptr){
+        if(ptr == nullptr){
+            return;
+        }
+        record_free(stored_size(ptr));
+        std::free(static_cast<char*>(ptr) - header_size);
+    }
+
+    //Over-aligned allocations: the header is as large as the alignment
+    void* allocate(size_t size, std::align_val_t alignment){
+        size_t align = std::max(static_cast<size_t>(alignment),header_size);
+        void* base = nullptr;
+        if(posix_memalign(&base,align,size + align) != 0){
+            return nullptr;
+        }
+        void* ptr = static_cast<char*>(base) + align;
+        stored_size(ptr) = size;
+        record_allocation(size);
+        return ptr;
+    }
+
+    void deallocate(void* ptr, std::align_val_t alignment){
+        if(ptr == nullptr){
+            return;
+        }
+        size_t align = std::max(static_cast<size_t>(alignment),header_size);
+        record_free(stored_size(ptr));
+        std::free(static_cast<char*>(ptr) - align);
+    }
+
+    template<typename... Alignment>
+    void* allocate_or_throw(size_t size, Alignment... alignment){
+        void* ptr = allocate(size,alignment...);
+        if(ptr == nullptr){
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    //Per phase statistics of the current thread, stored without allocating
+    struct Phase{
+        const char* name;
+        aoc::alloc::Statistics statistics;
+    };
+    constexpr int max_phases = 32;
+    thread_local std::array<Phase,max_phases> phases;
+    thread_local int n_phases = 0;
+    thread_local aoc::alloc::Statistics phase_start;
+
+    //Print the summary at exit, with the phases of the main thread (the
+    //phases of other threads are reported by their PhaseTimer)
+    struct Reporter{
+        ~Reporter(){
+            aoc::alloc::Statistics stats = aoc::alloc::total();
+            std::fprintf(stderr,"aoc_alloc summary: %lld allocations, %lld frees, %lld bytes allocated, peak heap %lld bytes, %lld bytes live at exit\n",
+                         stats.allocations,stats.frees,stats.bytes,stats.peak,stats.live);
+            for(int i = 0; i<n_phases; i++){
+                const aoc::alloc::Statistics& phase = phases[i].statistics;
+                std::fprintf(stderr,"  phase %-12s %14lld allocations %16lld bytes   peak heap %14lld bytes\n",
+                             phases[i].name,phase.allocations,phase.bytes,phase.peak);
+            }
+        }
+    } reporter;
+}
+
+namespace aoc::alloc{
+
+    Statistics total(){
+        Counters& c = counters();
+        Statistics stats;
+        stats.allocations = c.allocations.load(std::memory_order_relaxed);
+        stats.frees       = c.frees.load(std::memory_order_relaxed);
+        stats.bytes       = c.bytes.load(std::memory_order_relaxed);
+        stats.peak        = c.peak.load(std::memory_order_relaxed);
+        stats.live        = c.live.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    Statistics end_phase(const char* name){
+        ThreadCounters& t = thread_counters;
+        Statistics now;
+        now.allocations = t.allocations;
+        now.frees       = t.frees;
+        now.bytes       = t.bytes;
+        now.live        = t.live;
+        Statistics phase;
+        phase.allocations = now.allocations - phase_start.allocations;
+        phase.frees       = now.frees - phase_start.frees;
+        phase.bytes       = now.bytes - phase_start.bytes;
+        phase.peak        = t.phase_peak;
+        phase.live        = now.live;
+        t.phase_peak = now.live;
+        phase_start = now;
+        if(n_phases < max_phases){
+            phases[n_phases++] = {name,phase};
+        }
+        return phase;
+    }
+}
+
+void* operator new  (size_t size){ return allocate_or_throw(size); }
+void* operator new[](size_t size){ return allocate_or_throw(size); }
+void* operator new  (size_t size, const std::nothrow_t&) noexcept{ return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept{ return allocate(size); }
+void* operator new  (size_t size, std::align_val_t alignment){ return allocate_or_throw(size,alignment); }
+void* operator new[](size_t size, std::align_val_t alignment){ return allocate_or_throw(size,alignment); }
+void* operator new  (size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{ return allocate(size,alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{ return allocate(size,alignment); }
+
+void operator delete  (void* ptr) noexcept{ deallocate(ptr); }
+void operator delete[](void* ptr) noexcept{ deallocate(ptr); }
+void operator delete  (void* ptr, size_t) noexcept{ deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept{ deallocate(ptr); }
+void operator delete  (void* ptr, const std::nothrow_t&) noexcept{ deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept{ deallocate(ptr); }
+void operator delete  (void* ptr, std::align_val_t alignment) noexcept{ deallocate(ptr,alignment); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept{ deallocate(ptr,alignment); }
+void operator delete  (void* ptr, size_t, std::align_val_t alignment) noexcept{ deallocate(ptr,alignment); }
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept{ deallocate(ptr,alignment); }
+void operator delete  (void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept{ deallocate(ptr,alignment); }
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept{ deallocate(ptr,alignment); }
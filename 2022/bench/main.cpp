@@ -0,0 +1,369 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+
+//A single registered puzzle run (see aoc_add_benchmark in CMakeLists.txt)
+struct Benchmark{
+    std::string puzzle;       //Puzzle name, e.g. puzzle6
+    std::string part;         //Part: 1, 2 or all
+    std::string executable;   //Full path to the executable
+    std::string directory;    //Working directory (contains input.txt)
+    std::string arguments;    //Program arguments, separated by ';'
+};
+
+//Generated by CMake
+const std::vector<Benchmark> benchmarks = {
+    #include "benchmarks.inc"
+};
+
+//Timings of a single run, in nanoseconds
+struct Timing{
+    long long wall = 0;
+    std::map<std::string,long long> phases;   //As reported by aoc::PhaseTimer
+};
+
+//Summary statistics of a series of measurements, in nanoseconds
+struct Statistics{
+    long long min    = 0;
+    long long median = 0;
+    long long p95    = 0;
+};
+
+//Harness settings
+struct Settings{
+    int warmup = 1;
+    int repeat = 5;
+    bool perf = false;      //Also collect hardware performance counters
+    std::string json_file;
+    std::vector<std::string> filters;
+};
+
+//Hardware performance counters reported by aoc::PhaseTimer (if --perf is used)
+const std::vector<std::string> perf_events = {"cycles","instructions","l1d_misses","llc_misses","branch_misses","page_faults"};
+
+//Heap allocations reported by aoc::PhaseTimer (if the puzzle links aoc_alloc)
+const std::vector<std::string> allocation_events = {"allocations","alloc_bytes","peak_heap"};
+
+//Median counters (named <phase>.<event>) of every benchmark
+using CounterResults = std::vector<std::pair<const Benchmark*,std::map<std::string,long long>>>;
+
+Statistics statistics(std::vector<long long> values){
+    Statistics stats;
+    if(values.empty()){
+        return stats;
+    }
+    std::sort(values.begin(),values.end());
+    size_t n = values.size();
+    stats.min    = values[0];
+    stats.median = (n % 2 == 1) ? values[n/2] : (values[n/2-1] + values[n/2])/2;
+    //Nearest-rank percentile
+    size_t rank  = std::ceil(0.95*n);
+    stats.p95    = values[std::max<size_t>(rank,1)-1];
+    return stats;
+}
+
+//Run the puzzle once, in its own process. Standard output of the puzzle is
+//discarded, the phase timings are read from its standard error.
+//Returns false if the puzzle failed.
+bool run_once(const Benchmark& benchmark, const Settings& settings, Timing& timing){
+    int pipe_fds[2];
+    if(pipe(pipe_fds) != 0){
+        throw std::runtime_error("Could not create pipe");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if(pid < 0){
+        throw std::runtime_error("Could not fork");
+    }
+    if(pid == 0){
+        //Child: run the puzzle from its build directory
+        close(pipe_fds[0]);
+        int dev_null = open("/dev/null",O_WRONLY);
+        dup2(dev_null,STDOUT_FILENO);
+        dup2(pipe_fds[1],STDERR_FILENO);
+        if(chdir(benchmark.directory.c_str()) != 0){
+            _exit(127);
+        }
+        setenv("AOC_BENCH","1",1);
+        if(settings.perf){
+            setenv("AOC_PERF","1",1);
+        }
+
+        //Build the argument list
+        std::vector<std::string> arguments = {benchmark.executable};
+        std::stringstream argument_stream(benchmark.arguments);
+        std::string argument;
+        while(std::getline(argument_stream,argument,';')){
+            if(!argument.empty()){
+                arguments.push_back(argument);
+            }
+        }
+        std::vector<char*> argv;
+        for(auto& arg : arguments){
+            argv.push_back(arg.data());
+        }
+        argv.push_back(nullptr);
+        execv(benchmark.executable.c_str(),argv.data());
+        _exit(127);
+    }
+
+    //Parent: collect the phase timings
+    close(pipe_fds[1]);
+    std::string output;
+    char buffer[4096];
+    ssize_t n_read;
+    while((n_read = read(pipe_fds[0],buffer,sizeof(buffer))) > 0){
+        output.append(buffer,n_read);
+    }
+    close(pipe_fds[0]);
+
+    int status;
+    waitpid(pid,&status,0);
+    auto end = std::chrono::steady_clock::now();
+    timing.wall = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    //Lines look like: aoc_bench <phase> <nanoseconds>
+    std::stringstream output_stream(output);
+    std::string line;
+    while(std::getline(output_stream,line)){
+        std::stringstream line_stream(line);
+        std::string tag, phase;
+        long long ns;
+        if(line_stream >> tag >> phase >> ns && tag == "aoc_bench"){
+            timing.phases[phase] += ns;
+        }
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+//Check if this benchmark was selected on the command line.
+//Filters are either a puzzle (puzzle6) or a puzzle and part (puzzle6/2)
+bool selected(const Benchmark& benchmark, const Settings& settings){
+    if(settings.filters.empty()){
+        return true;
+    }
+    for(const auto& filter : settings.filters){
+        if(filter == benchmark.puzzle || filter == benchmark.puzzle + "/" + benchmark.part){
+            return true;
+        }
+    }
+    return false;
+}
+
+//Puzzle number, used to sort puzzle10 after puzzle9
+int puzzle_number(const std::string& puzzle){
+    size_t digits = puzzle.find_first_of("0123456789");
+    return (digits == std::string::npos) ? 0 : std::stoi(puzzle.substr(digits));
+}
+
+std::string format_ms(long long ns){
+    std::stringstream stream;
+    stream << std::fixed << std::setprecision(3) << ns/1e6;
+    return stream.str();
+}
+
+//Table of counters per benchmark and phase, "-" if a counter is not available.
+//Optionally, the instructions per cycle are added.
+void print_counters(const CounterResults& results, const std::vector<std::string>& events, bool ipc){
+    std::cout << std::endl << std::left << std::setw(10) << "puzzle" << std::setw(6) << "part" << std::setw(7) << "phase" << std::right;
+    for(const auto& event : events){
+        std::cout << std::setw(15) << event;
+    }
+    std::cout << (ipc ? "     IPC" : "") << std::endl;
+    for(const auto& result : results){
+        for(const std::string phase : {"parse","solve"}){
+            std::cout << std::left << std::setw(10) << result.first->puzzle << std::setw(6) << result.first->part << std::setw(7) << phase << std::right;
+            auto counter = [&](const std::string& event){
+                auto it = result.second.find(phase + "." + event);
+                return (it == result.second.end()) ? -1LL : it->second;
+            };
+            for(const auto& event : events){
+                long long value = counter(event);
+                std::cout << std::setw(15) << (value < 0 ? std::string("-") : std::to_string(value));
+            }
+            if(ipc){
+                long long cycles       = counter("cycles");
+                long long instructions = counter("instructions");
+                std::stringstream ratio;
+                if(cycles > 0 && instructions >= 0){
+                    ratio << std::fixed << std::setprecision(2) << double(instructions)/cycles;
+                }else{
+                    ratio << "-";
+                }
+                std::cout << std::setw(8) << ratio.str();
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+void print_usage(){
+    std::cout << "Usage: ./aoc_bench [--warmup N] [--repeat N] [--perf] [--json <file>] [--list] [puzzle[/part] ...]" << std::endl;
+    std::cout << "Runs every registered puzzle (and part), and reports min, median and p95 of" << std::endl;
+    std::cout << "the wall time, and of the parse and solve phases." << std::endl;
+    std::cout << "With --perf, the median hardware counters (Linux perf_event_open) of the parse" << std::endl;
+    std::cout << "and solve phases are reported as well. Puzzles that link aoc_alloc report their" << std::endl;
+    std::cout << "heap allocations per phase." << std::endl;
+}
+
+//End-to-end benchmark harness. Runs every puzzle (and part) in its own
+//process, with a number of warmup runs and timed repeats.
+int main(int argc, char *argv[]){
+
+    //Parse the program arguments
+    Settings settings;
+    for(int i = 1; i<argc; i++){
+        std::string arg = argv[i];
+        if((arg == "--warmup" || arg == "--repeat" || arg == "--json") && i+1 >= argc){
+            throw std::runtime_error("Missing value for " + arg);
+        }
+        if(arg == "--warmup"){
+            settings.warmup = std::stoi(argv[++i]);
+        }else if(arg == "--repeat"){
+            settings.repeat = std::max(1,std::stoi(argv[++i]));
+        }else if(arg == "--perf"){
+            settings.perf = true;
+        }else if(arg == "--json"){
+            settings.json_file = argv[++i];
+        }else if(arg == "--list"){
+            for(const auto& benchmark : benchmarks){
+                std::cout << benchmark.puzzle << "/" << benchmark.part << std::endl;
+            }
+            return 0;
+        }else if(arg == "--help" || arg == "-h"){
+            print_usage();
+            return 0;
+        }else{
+            settings.filters.push_back(arg);
+        }
+    }
+
+    //Run the puzzles in numerical order
+    std::vector<Benchmark> selection;
+    for(const auto& benchmark : benchmarks){
+        if(selected(benchmark,settings)){
+            selection.push_back(benchmark);
+        }
+    }
+    std::stable_sort(selection.begin(),selection.end(),[](const Benchmark& a, const Benchmark& b){
+        return std::make_pair(puzzle_number(a.puzzle),a.part) < std::make_pair(puzzle_number(b.puzzle),b.part);
+    });
+
+    //Table header (times in ms)
+    const std::vector<std::string> columns = {"wall min","wall med","wall p95","parse med","parse p95","solve med","solve p95"};
+    std::cout << std::left << std::setw(10) << "puzzle" << std::setw(6) << "part" << std::right;
+    for(const auto& column : columns){
+        std::cout << std::setw(12) << column;
+    }
+    std::cout << "   (ms)" << std::endl;
+
+    std::stringstream json;
+    json << "{\n  \"warmup\": " << settings.warmup << ",\n  \"repeat\": " << settings.repeat << ",\n  \"results\": [";
+    bool first_result = true;
+
+    //Median counters per benchmark and phase, reported after the timings
+    CounterResults counter_results;
+
+    int n_failed = 0;
+    for(const auto& benchmark : selection){
+        std::cout << std::left << std::setw(10) << benchmark.puzzle << std::setw(6) << benchmark.part << std::right << std::flush;
+
+        //Warmup runs are not timed, but do fill the page cache
+        bool success = true;
+        Timing timing;
+        for(int i = 0; i<settings.warmup && success; i++){
+            success = run_once(benchmark,settings,timing);
+        }
+        std::vector<long long> wall, parse, solve;
+        std::map<std::string,std::vector<long long>> counters;
+        for(int i = 0; i<settings.repeat && success; i++){
+            timing = Timing();
+            success = run_once(benchmark,settings,timing);
+            wall.push_back(timing.wall);
+            parse.push_back(timing.phases["parse"]);
+            solve.push_back(timing.phases["solve"]);
+            for(const auto& phase : timing.phases){
+                if(phase.first.find('.') != std::string::npos){
+                    counters[phase.first].push_back(phase.second);
+                }
+            }
+        }
+        if(!success){
+            std::cout << "   FAILED" << std::endl;
+            n_failed++;
+            continue;
+        }
+
+        Statistics wall_stats  = statistics(wall);
+        Statistics parse_stats = statistics(parse);
+        Statistics solve_stats = statistics(solve);
+        for(long long ns : { wall_stats.min,  wall_stats.median,  wall_stats.p95,
+                            parse_stats.median, parse_stats.p95,
+                            solve_stats.median, solve_stats.p95}){
+            std::cout << std::setw(12) << format_ms(ns);
+        }
+        std::cout << std::endl;
+
+        //Machine readable output
+        auto json_stats = [&json](const char* name, const Statistics& stats){
+            json << "\"" << name << "\": {\"min\": " << stats.min << ", \"median\": " << stats.median << ", \"p95\": " << stats.p95 << "}";
+        };
+        json << (first_result ? "\n" : ",\n");
+        json << "    {\"puzzle\": \"" << benchmark.puzzle << "\", \"part\": \"" << benchmark.part << "\", \"runs\": " << wall.size() << ", ";
+        json_stats("wall_ns",wall_stats);
+        json << ", ";
+        json_stats("parse_ns",parse_stats);
+        json << ", ";
+        json_stats("solve_ns",solve_stats);
+        if(!counters.empty()){
+            //Counters are named <phase>.<event>
+            std::map<std::string,long long> medians;
+            for(const auto& counter : counters){
+                medians[counter.first] = statistics(counter.second).median;
+            }
+            json << ", \"counters\": {";
+            bool first_counter = true;
+            for(const auto& median : medians){
+                json << (first_counter ? "" : ", ") << "\"" << median.first << "\": " << median.second;
+                first_counter = false;
+            }
+            json << "}";
+            counter_results.emplace_back(&benchmark,medians);
+        }
+        json << "}";
+        first_result = false;
+    }
+    json << "\n  ]\n}\n";
+
+    //Counter tables (medians)
+    if(settings.perf){
+        print_counters(counter_results,perf_events,true);
+    }
+    bool allocations_tracked = std::any_of(counter_results.begin(),counter_results.end(),[](const auto& result){
+        return result.second.count("solve.allocations") > 0;
+    });
+    if(allocations_tracked){
+        print_counters(counter_results,allocation_events,false);
+    }
+
+    if(settings.json_file == "-"){
+        std::cout << json.str();
+    }else if(!settings.json_file.empty()){
+        std::ofstream json_stream(settings.json_file);
+        json_stream << json.str();
+        std::cout << "JSON results written to " << settings.json_file << std::endl;
+    }
+
+    return n_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+#Runs a puzzle for a golden-answer test (registered with aoc_add_test):
+#  cmake -DCOMMAND=<executable> -DARGUMENTS=<arguments> -DEXPECTED=<text...>
+#        [-DEXPECTED_STDERR=<text...>] -DBUDGET_MS=<milliseconds> -P aoc_run_test.cmake
+#The test passes if the puzzle succeeds, its output contains every expected
+#text (and its error output every EXPECTED_STDERR text), and the phases it
+#reports to aoc_bench (parse, solve) took less than the budget in total. Run from the directory that contains input.txt.
+
+separate_arguments(arguments UNIX_COMMAND "${ARGUMENTS}")
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E env AOC_BENCH=1 ${COMMAND} ${arguments}
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE  errors
+    RESULT_VARIABLE result
+)
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${COMMAND} ${ARGUMENTS} failed (${result}):\n${output}${errors}")
+endif()
+
+#Expected texts are separated by "|"
+string(REPLACE "|" ";" expected_list "${EXPECTED}")
+foreach(expected ${expected_list})
+    string(FIND "${output}" "${expected}" position)
+    if(position EQUAL -1)
+        message(FATAL_ERROR "Expected answer not found: \"${expected}\"\nOutput:\n${output}")
+    endif()
+endforeach()
+string(REPLACE "|" ";" expected_list "${EXPECTED_STDERR}")
+foreach(expected ${expected_list})
+    string(FIND "${errors}" "${expected}" position)
+    if(position EQUAL -1)
+        message(FATAL_ERROR "Expected error output not found: \"${expected}\"\nError output:\n${errors}")
+    endif()
+endforeach()
+
+#Total time of the phases, from the lines:  aoc_bench <phase> <nanoseconds>
+#(lines of the form aoc_bench <phase>.<counter> <n> are skipped)
+string(REGEX MATCHALL "aoc_bench [A-Za-z_]+ [0-9]+" phases "${errors}")
+set(total_ns 0)
+foreach(phase ${phases})
+    string(REGEX REPLACE "aoc_bench [A-Za-z_]+ ([0-9]+)" "\\1" ns "${phase}")
+    math(EXPR total_ns "${total_ns} + ${ns}")
+endforeach()
+math(EXPR total_ms "${total_ns} / 1000000")
+math(EXPR budget_ns "${BUDGET_MS} * 1000000")
+if(total_ns GREATER budget_ns)
+    message(FATAL_ERROR "Too slow: took ${total_ms} ms, the budget is ${BUDGET_MS} ms")
+endif()
+message(STATUS "Took ${total_ms} ms (budget ${BUDGET_MS} ms)")
\ No newline at end of file
@@ -0,0 +1,39 @@
+#Protocol test of the solver daemon (registered in served/CMakeLists.txt):
+#  cmake -DSERVER=<aoc_served> -DSOCKET=<path> -P aoc_served_test.cmake
+#Starts the server, and (at the same time) a client that waits for it to
+#listen, sends a few requests, and shuts the server down. The test passes if
+#both exit as expected, and the responses contain the golden answers of
+#puzzle 6. Run from the build directory (the server's directory).
+
+#The commands of execute_process run concurrently (as a pipeline)
+execute_process(
+    COMMAND ${SERVER} --socket ${SOCKET} --threads 2
+    COMMAND ${SERVER} --socket ${SOCKET}
+            --send "list"
+            --send "solve puzzle6 all puzzle6/input.txt"
+            --send "solve puzzle6 1 ../puzzle6/input.txt"
+            --send "stats"
+            --send "shutdown"
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE  errors
+    RESULTS_VARIABLE results
+    TIMEOUT 60
+)
+
+#The client fails, since the path outside the server's directory is refused
+if(NOT results STREQUAL "0;1")
+    message(FATAL_ERROR "Unexpected exit codes (server;client): ${results}\n${output}${errors}")
+endif()
+
+set(expected_list
+    "puzzle6\n"
+    "marker found at 1912\nmarker found at 2122\n"
+    "Input files must be inside the server's directory (../puzzle6/input.txt)"
+    "puzzle6/all requests 1 errors 0"
+)
+foreach(expected ${expected_list})
+    string(FIND "${output}" "${expected}" position)
+    if(position EQUAL -1)
+        message(FATAL_ERROR "Expected response not found: \"${expected}\"\nOutput:\n${output}${errors}")
+    endif()
+endforeach()
@@ -0,0 +1,30 @@
+#Test of the puzzle 14 input generator (registered in gen_inputs/CMakeLists.txt):
+#  cmake -DGEN_INPUTS=<gen_inputs> -DPUZZLE=<puzzle14> -P gen_inputs_test.cmake
+#Solves part 1 for generated inputs of increasing size. The test passes if
+#the sand always ends up in the abyss (rather than at the source), and more
+#sand is dropped for larger inputs.
+set(previous_grains 0)
+foreach(size 200 2000 20000)
+    execute_process(
+        COMMAND ${GEN_INPUTS} puzzle14 --size ${size} --seed 1
+        COMMAND ${PUZZLE} - 1
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE  errors
+        RESULTS_VARIABLE results
+        TIMEOUT 60
+    )
+    if(NOT results STREQUAL "0;0")
+        message(FATAL_ERROR "Unexpected exit codes (gen_inputs;puzzle14) for size ${size}: ${results}\n${errors}")
+    endif()
+    string(REGEX MATCH "falling into the abbyss after ([0-9]+) grains" match "${output}")
+    if(NOT match)
+        string(REGEX MATCH "[^\n]*grains of sand" match "${output}")
+        message(FATAL_ERROR "Sand does not fall into the abyss for size ${size}: ${match}")
+    endif()
+    set(grains ${CMAKE_MATCH_1})
+    if(NOT grains GREATER previous_grains)
+        message(FATAL_ERROR "Size ${size} needs ${grains} grains of sand, no more than a smaller input (${previous_grains})")
+    endif()
+    message(STATUS "size ${size}: ${grains} grains of sand")
+    set(previous_grains ${grains})
+endforeach()
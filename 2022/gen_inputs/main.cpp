@@ -0,0 +1,789 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <set>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <functional>
+#include <cmath>
+
+/*
+    Synthetic input generators for the 2022 puzzles. Every generator writes a
+    valid puzzle input of a requested size (the meaning of "size" differs per
+    puzzle, see --list), which is reproducible for a given seed.
+*/
+
+using rng_type = std::mt19937_64;
+
+//Random integer in [lo,hi] (inclusive)
+long long random_int(rng_type& rng, long long lo, long long hi){
+    return std::uniform_int_distribution<long long>(lo,hi)(rng);
+}
+
+//Random value between 0 and 1
+double random_real(rng_type& rng){
+    return std::uniform_real_distribution<double>(0.0,1.0)(rng);
+}
+
+//Random lowercase name of a given length
+std::string random_name(rng_type& rng, int length){
+    std::string name;
+    for(int i = 0; i<length; i++){
+        name += char('a' + random_int(rng,0,25));
+    }
+    return name;
+}
+
+//Puzzle 1: size = number of elves
+void generate_puzzle1(std::ostream& out, long long size, rng_type& rng){
+    for(long long elf = 0; elf<size; elf++){
+        if(elf > 0){
+            out << "\n";
+        }
+        int n_items = random_int(rng,1,15);
+        for(int i = 0; i<n_items; i++){
+            out << random_int(rng,1000,70000) << "\n";
+        }
+    }
+}
+
+//Puzzle 2: size = number of rounds
+void generate_puzzle2(std::ostream& out, long long size, rng_type& rng){
+    for(long long i = 0; i<size; i++){
+        out << char('A' + random_int(rng,0,2)) << " " << char('X' + random_int(rng,0,2)) << "\n";
+    }
+}
+
+//Puzzle 3: size = number of rucksacks (rounded up to a multiple of 3).
+//Every rucksack has exactly one item type in both compartments, and every
+//group of three elves has exactly one item type (the badge) in common.
+void generate_puzzle3(std::ostream& out, long long size, rng_type& rng){
+    const std::string items = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for(long long group = 0; group<(size+2)/3; group++){
+        //Choose the badge, and divide the other item types over the three elves
+        std::string pool = items;
+        std::shuffle(pool.begin(),pool.end(),rng);
+        char badge = pool.back();
+        pool.pop_back();
+        for(int elf = 0; elf<3; elf++){
+            std::string own_items = pool.substr(elf*17,17);
+            char duplicate        = own_items[0];
+            std::string left_pool  = own_items.substr(1,8);
+            std::string right_pool = own_items.substr(9,8);
+            int length = random_int(rng,4,16);
+            std::string left  = {duplicate, badge};
+            std::string right = {duplicate};
+            while(int(left.size())  < length){ left  += left_pool [random_int(rng,0,7)]; }
+            while(int(right.size()) < length){ right += right_pool[random_int(rng,0,7)]; }
+            std::shuffle(left.begin(),left.end(),rng);
+            std::shuffle(right.begin(),right.end(),rng);
+            //Randomly put the badge in the left or right compartment
+            if(random_int(rng,0,1)){
+                std::swap(left,right);
+            }
+            out << left << right << "\n";
+        }
+    }
+}
+
+//Puzzle 4: size = number of pairs of elves
+void generate_puzzle4(std::ostream& out, long long size, rng_type& rng){
+    for(long long i = 0; i<size; i++){
+        int a = random_int(rng,1,99);
+        int b = random_int(rng,a,99);
+        int c = random_int(rng,1,99);
+        int d = random_int(rng,c,99);
+        out << a << "-" << b << "," << c << "-" << d << "\n";
+    }
+}
+
+//Puzzle 5: size = number of moves. The solver expects 9 stacks. Moves never
+//empty a stack completely, so every stack has a top crate at the end.
+void generate_puzzle5(std::ostream& out, long long size, rng_type& rng){
+    const int N_crates = 9;
+    std::array<int,N_crates> heights;
+    for(int& height : heights){
+        height = random_int(rng,2,10);
+    }
+    int max_height = *std::max_element(heights.begin(),heights.end());
+    for(int row = max_height; row>0; row--){
+        std::string line;
+        for(int i = 0; i<N_crates; i++){
+            line += (heights[i] >= row) ? std::string("[") + char('A' + random_int(rng,0,25)) + "]" : "   ";
+            line += " ";
+        }
+        out << line << "\n";
+    }
+    for(int i = 0; i<N_crates; i++){
+        out << " " << i+1 << "  ";
+    }
+    out << "\n\n";
+    for(long long i = 0; i<size; i++){
+        int source, target;
+        do{
+            source = random_int(rng,0,N_crates-1);
+        }while(heights[source] < 2);
+        do{
+            target = random_int(rng,0,N_crates-1);
+        }while(target == source);
+        int quantity = random_int(rng,1,std::min(heights[source]-1,10));
+        heights[source] -= quantity;
+        heights[target] += quantity;
+        out << "move " << quantity << " from " << source+1 << " to " << target+1 << "\n";
+    }
+}
+
+//Puzzle 6: size = length of the datastream. The markers are at the very end,
+//so the full stream needs to be scanned.
+void generate_puzzle6(std::ostream& out, long long size, rng_type& rng){
+    const std::string marker = "defghijklmnopq";
+    for(long long i = 0; i<std::max(0LL,size-(long long)marker.size()); i++){
+        //Only 3 distinct characters -> never 4 unique characters in a row
+        out << char('a' + random_int(rng,0,2));
+    }
+    out << marker << "\n";
+}
+
+//Puzzle 7: size = number of files and directories. The total size of all
+//files is about 50.000.000, so there is always a directory that can be removed.
+void generate_puzzle7(std::ostream& out, long long size, rng_type& rng){
+    struct Directory{
+        std::vector<std::pair<std::string,long long>> files;
+        std::vector<std::pair<std::string,int>> subdirs;    //name, index
+    };
+    std::vector<Directory> dirs(1);
+    std::vector<int> depth = {0};
+
+    //Grow a random tree
+    long long n_files = 0;
+    for(long long i = 0; i<size; i++){
+        int parent = random_int(rng,0,dirs.size()-1);
+        std::string name = random_name(rng,random_int(rng,3,8));
+        if(random_real(rng) < 0.25 && depth[parent] < 30){
+            dirs[parent].subdirs.push_back({name,int(dirs.size())});
+            dirs.emplace_back();
+            depth.push_back(depth[parent]+1);
+        }else{
+            dirs[parent].files.push_back({name + "." + random_name(rng,3),random_int(rng,1,1000)});
+            n_files++;
+        }
+    }
+    //Root needs at least one subdirectory
+    if(dirs[0].subdirs.empty()){
+        dirs[0].subdirs.push_back({"a",int(dirs.size())});
+        dirs.emplace_back();
+        dirs.back().files.push_back({"a.txt",1});
+    }
+
+    //Scale the file sizes to a total of ~50.000.000, but keep the root files small
+    long long weight = 0;
+    for(size_t d = 1; d<dirs.size(); d++){
+        for(auto& file : dirs[d].files){
+            weight += file.second;
+        }
+    }
+    double scale = 50000000.0/std::max(1LL,weight);
+    for(size_t d = 1; d<dirs.size(); d++){
+        for(auto& file : dirs[d].files){
+            file.second = std::max(1LL,(long long)(file.second*scale));
+        }
+    }
+
+    //Write the terminal session (depth first)
+    std::function<void(int)> write_dir = [&](int index){
+        out << "$ ls\n";
+        //Names must be unique within a directory
+        std::set<std::string> names;
+        for(const auto& subdir : dirs[index].subdirs){
+            if(names.insert(subdir.first).second){
+                out << "dir " << subdir.first << "\n";
+            }
+        }
+        for(const auto& file : dirs[index].files){
+            if(names.insert(file.first).second){
+                out << file.second << " " << file.first << "\n";
+            }
+        }
+        std::set<std::string> visited;
+        for(const auto& subdir : dirs[index].subdirs){
+            if(visited.insert(subdir.first).second){
+                out << "$ cd " << subdir.first << "\n";
+                write_dir(subdir.second);
+                out << "$ cd ..\n";
+            }
+        }
+    };
+    out << "$ cd /\n";
+    write_dir(0);
+}
+
+//Puzzle 8: size = width and height of the (square) tree grid
+void generate_puzzle8(std::ostream& out, long long size, rng_type& rng){
+    for(long long row = 0; row<size; row++){
+        std::string line(size,'0');
+        for(char& c : line){
+            c = '0' + random_int(rng,0,9);
+        }
+        out << line << "\n";
+    }
+}
+
+//Puzzle 9: size = number of head motions
+void generate_puzzle9(std::ostream& out, long long size, rng_type& rng){
+    const std::string directions = "UDLR";
+    for(long long i = 0; i<size; i++){
+        out << directions[random_int(rng,0,3)] << " " << random_int(rng,1,20) << "\n";
+    }
+}
+
+//Puzzle 10: size = number of instructions
+void generate_puzzle10(std::ostream& out, long long size, rng_type& rng){
+    for(long long i = 0; i<size; i++){
+        if(random_real(rng) < 0.3){
+            out << "noop\n";
+        }else{
+            out << "addx " << random_int(rng,-10,10) << "\n";
+        }
+    }
+}
+
+//Puzzle 11: size = total number of items. There are always 8 monkeys, with
+//distinct prime divisors (the product of all divisors must fit in an int)
+void generate_puzzle11(std::ostream& out, long long size, rng_type& rng){
+    const int N_monkeys = 8;
+    std::array<int,N_monkeys> primes = {2,3,5,7,11,13,17,19};
+    std::shuffle(primes.begin(),primes.end(),rng);
+    for(int monkey = 0; monkey<N_monkeys; monkey++){
+        if(monkey > 0){
+            out << "\n";
+        }
+        out << "Monkey " << monkey << ":\n";
+        out << "  Starting items: ";
+        long long n_items = size/N_monkeys + (monkey < size%N_monkeys);
+        for(long long i = 0; i<n_items; i++){
+            out << (i > 0 ? ", " : "") << random_int(rng,50,99);
+        }
+        out << "\n";
+        double operation = random_real(rng);
+        if(operation < 0.15){
+            out << "  Operation: new = old * old\n";
+        }else if(operation < 0.5){
+            out << "  Operation: new = old * " << random_int(rng,2,19) << "\n";
+        }else{
+            out << "  Operation: new = old + " << random_int(rng,1,8) << "\n";
+        }
+        out << "  Test: divisible by " << primes[monkey] << "\n";
+        //Never throw to yourself
+        int if_true, if_false;
+        do{ if_true  = random_int(rng,0,N_monkeys-1); }while(if_true  == monkey);
+        do{ if_false = random_int(rng,0,N_monkeys-1); }while(if_false == monkey || if_false == if_true);
+        out << "    If true: throw to monkey "  << if_true  << "\n";
+        out << "    If false: throw to monkey " << if_false << "\n";
+    }
+}
+
+//Puzzle 12: size = width and height of the (square) height map. The terrain
+//climbs towards E, so a route from S to E always exists.
+void generate_puzzle12(std::ostream& out, long long size, rng_type& rng){
+    size = std::max(2LL,size);
+    long long end_row = random_int(rng,size/4,3*size/4);
+    long long end_col = random_int(rng,size/4,3*size/4);
+    //Distance over which the terrain climbs one unit (the start is at height 0)
+    double slope = std::max(1.0,(end_row + end_col)/25.0);
+    for(long long row = 0; row<size; row++){
+        std::string line(size,'a');
+        for(long long col = 0; col<size; col++){
+            long long distance = std::abs(row-end_row) + std::abs(col-end_col);
+            int height = std::max(0LL,25 - (long long)(distance/slope));
+            //Random pits (going down is always allowed). The route along
+            //row 0 and then column end_col only climbs, and has no pits, so
+            //the end can always be reached.
+            bool on_route = (row == 0 && col <= end_col) || (col == end_col && row <= end_row);
+            if(!on_route && random_real(rng) < 0.2){
+                height = random_int(rng,0,height);
+            }
+            line[col] = 'a' + height;
+        }
+        if(row == end_row){
+            line[end_col] = 'E';
+        }
+        if(row == 0){
+            line[0] = 'S';
+        }
+        out << line << "\n";
+    }
+}
+
+//Puzzle 13: size = number of packet pairs
+void generate_puzzle13(std::ostream& out, long long size, rng_type& rng){
+    std::function<std::string(int)> random_list = [&](int depth){
+        std::string list = "[";
+        int length = random_int(rng,0,5);
+        for(int i = 0; i<length; i++){
+            if(i > 0){
+                list += ",";
+            }
+            if(depth < 4 && random_real(rng) < 0.3){
+                list += random_list(depth+1);
+            }else{
+                list += std::to_string(random_int(rng,0,10));
+            }
+        }
+        return list + "]";
+    };
+    for(long long i = 0; i<size; i++){
+        if(i > 0){
+            out << "\n";
+        }
+        out << random_list(0) << "\n" << random_list(0) << "\n";
+    }
+}
+
+//Puzzle 14: size = number of rock paths (cups and ledges). The paths are
+//spread evenly over the cone |x-500| <= y/2 below the sand source at (500,0),
+//whose depth grows with the number of paths. A pile of sand that reaches the
+//source needs support up to |x-500| = y, which the rocks never give, so part 1
+//always ends with sand falling into the abyss (past the lowest rocks).
+void generate_puzzle14(std::ostream& out, long long size, rng_type& rng){
+    long long depth = 20 + std::sqrt(size)*10;
+    //Keep a point of a path inside the cone
+    auto inside_x = [](long long x, long long y){
+        return std::clamp(x,500-y/2,500+y/2);
+    };
+    auto inside_y = [depth](long long x, long long y){
+        return std::clamp(y,std::max(5LL,2*std::abs(x-500)),depth);
+    };
+    for(long long i = 0; i<size; i++){
+        //The cone widens with depth, so the depth of the paths is distributed
+        //like sqrt(uniform), to cover its area evenly
+        long long y = inside_y(500,depth*std::sqrt(random_real(rng)));
+        long long x = random_int(rng,500-y/2,500+y/2);
+        out << x << "," << y;
+        if(random_int(rng,0,1) == 0){
+            //A cup: down, sideways, and back up again
+            long long bottom = inside_y(x,y + random_int(rng,2,8));
+            long long x2     = inside_x(x + random_int(rng,-10,10),y);
+            out << " -> " << x << "," << bottom << " -> " << x2 << "," << bottom << " -> " << x2 << "," << y;
+        }else{
+            //A ledge: alternate horizontal and vertical segments
+            int n_segments = random_int(rng,1,5);
+            for(int segment = 0; segment<n_segments; segment++){
+                if(segment % 2 == 0){
+                    x = inside_x(x + random_int(rng,-6,6),y);
+                }else{
+                    y = inside_y(x,y + random_int(rng,-4,4));
+                }
+                out << " -> " << x << "," << y;
+            }
+        }
+        out << "\n";
+    }
+}
+
+//Puzzle 15: size = number of sensors. Four sensors in the corners of the
+//search area reach up to (but not including) a hidden position P, so together
+//they cover everything except P. The other sensors are placed randomly, and
+//never reach P either.
+void generate_puzzle15(std::ostream& out, long long size, rng_type& rng){
+    const long long max_coord = 4000000;
+    long long px = random_int(rng,1,max_coord-1);
+    long long py = random_int(rng,1,max_coord-1);
+    //The corner sensors cover x+y < px+py, x+y > px+py, x-y < px-py and x-y > px-py
+    for(long long x : {0LL,max_coord}){
+        for(long long y : {0LL,max_coord}){
+            long long radius = std::abs(x-px) + std::abs(y-py) - 1;
+            out << "Sensor at x=" << x << ", y=" << y << ": closest beacon is at x="
+                << (x == 0 ? x + radius : x - radius) << ", y=" << y << "\n";
+        }
+    }
+    for(long long i = 0; i<size; i++){
+        long long x = random_int(rng,0,max_coord);
+        long long y = random_int(rng,0,max_coord);
+        long long distance = std::abs(x-px) + std::abs(y-py);
+        if(distance == 0){
+            x = (px+1);
+            distance = 1;
+        }
+        long long radius = random_int(rng,0,std::min(distance-1,max_coord/4));
+        long long dx = random_int(rng,0,radius);
+        long long dy = radius - dx;
+        long long beacon_x = x + (random_int(rng,0,1) ? dx : -dx);
+        long long beacon_y = y + (random_int(rng,0,1) ? dy : -dy);
+        out << "Sensor at x=" << x << ", y=" << y << ": closest beacon is at x="
+            << beacon_x << ", y=" << beacon_y << "\n";
+    }
+}
+
+//Puzzle 16: size = number of valves. The number of functional valves (nonzero
+//flowrate) is capped at 15, since the solvers are exponential in that number.
+void generate_puzzle16(std::ostream& out, long long size, rng_type& rng){
+    size = std::clamp(size,2LL,676LL);
+    //All two letter names, AA is always present (start valve)
+    std::vector<std::string> names;
+    for(char a = 'A'; a<='Z'; a++){
+        for(char b = 'A'; b<='Z'; b++){
+            if(a != 'A' || b != 'A'){
+                names.push_back(std::string{a,b});
+            }
+        }
+    }
+    std::shuffle(names.begin(),names.end(),rng);
+    names.resize(size-1);
+    names.insert(names.begin(),"AA");
+
+    //Random spanning tree, plus some extra tunnels
+    std::vector<std::set<int>> tunnels(size);
+    for(int i = 1; i<size; i++){
+        int j = random_int(rng,0,i-1);
+        tunnels[i].insert(j);
+        tunnels[j].insert(i);
+    }
+    for(int i = 0; i<size/3; i++){
+        int a = random_int(rng,0,size-1);
+        int b = random_int(rng,0,size-1);
+        if(a != b){
+            tunnels[a].insert(b);
+            tunnels[b].insert(a);
+        }
+    }
+
+    //Functional valves (never the start valve)
+    std::vector<int> flowrates(size,0);
+    std::vector<int> order(size-1);
+    std::iota(order.begin(),order.end(),1);
+    std::shuffle(order.begin(),order.end(),rng);
+    for(int i = 0; i<std::min<long long>(15,size-1); i++){
+        flowrates[order[i]] = random_int(rng,2,25);
+    }
+
+    for(int i = 0; i<size; i++){
+        out << "Valve " << names[i] << " has flow rate=" << flowrates[i] << "; ";
+        out << (tunnels[i].size() == 1 ? "tunnel leads to valve " : "tunnels lead to valves ");
+        bool first = true;
+        for(int j : tunnels[i]){
+            out << (first ? "" : ", ") << names[j];
+            first = false;
+        }
+        out << "\n";
+    }
+}
+
+//Puzzle 17: size = length of the jet pattern
+void generate_puzzle17(std::ostream& out, long long size, rng_type& rng){
+    for(long long i = 0; i<size; i++){
+        out << (random_int(rng,0,1) ? '>' : '<');
+    }
+    out << "\n";
+}
+
+//Puzzle 18: size = number of cubes. The cubes form a random blob with
+//internal air pockets, the bounding box grows with the number of cubes.
+void generate_puzzle18(std::ostream& out, long long size, rng_type& rng){
+    long long extent = std::max(20LL,(long long)std::ceil(std::cbrt(size/0.4)));
+    size = std::min(size,extent*extent*extent);
+    double center = (extent-1)/2.0;
+    std::set<std::array<long long,3>> cubes;
+    while((long long)cubes.size() < size){
+        //Points are more likely to be picked close to the center
+        std::array<long long,3> cube;
+        for(auto& coord : cube){
+            double offset = (random_real(rng) + random_real(rng) - 1.0)*extent/2.0;
+            coord = std::clamp((long long)std::lround(center + offset),0LL,extent-1);
+        }
+        cubes.insert(cube);
+    }
+    std::vector<std::array<long long,3>> shuffled(cubes.begin(),cubes.end());
+    std::shuffle(shuffled.begin(),shuffled.end(),rng);
+    for(const auto& cube : shuffled){
+        out << cube[0] << "," << cube[1] << "," << cube[2] << "\n";
+    }
+}
+
+//Puzzle 19: size = number of blueprints (at least 3, part 2 uses the first 3)
+void generate_puzzle19(std::ostream& out, long long size, rng_type& rng){
+    for(long long i = 1; i<=std::max(3LL,size); i++){
+        out << "Blueprint " << i << ": "
+            << "Each ore robot costs "      << random_int(rng,2,4) << " ore. "
+            << "Each clay robot costs "     << random_int(rng,2,4) << " ore. "
+            << "Each obsidian robot costs " << random_int(rng,2,4) << " ore and " << random_int(rng,5,20) << " clay. "
+            << "Each geode robot costs "    << random_int(rng,2,4) << " ore and " << random_int(rng,5,20) << " obsidian.\n";
+    }
+}
+
+//Puzzle 20: size = number of values. Exactly one value is 0.
+void generate_puzzle20(std::ostream& out, long long size, rng_type& rng){
+    size = std::max(size,4LL);
+    long long zero = random_int(rng,0,size-1);
+    for(long long i = 0; i<size; i++){
+        long long value = 0;
+        while(i != zero && value == 0){
+            value = random_int(rng,-10000,10000);
+        }
+        out << value << "\n";
+    }
+}
+
+//Puzzle 21: size = number of monkeys. The monkeys form a tree with a deep
+//spine from root to humn. Side branches are random expressions that evaluate
+//to exact integers. The humn branch is linear in humn (only +, - and small
+//multiplications), so part 2 has an integer solution.
+void generate_puzzle21(std::ostream& out, long long size, rng_type& rng){
+    std::set<std::string> used_names = {"root","humn"};
+    auto new_name = [&](){
+        std::string name;
+        do{
+            name = random_name(rng,4);
+        }while(!used_names.insert(name).second);
+        return name;
+    };
+
+    std::vector<std::string> lines;
+
+    //Random expression with n_nodes monkeys (odd number) that yields value (>0)
+    std::function<std::string(long long,long long)> expression = [&](long long value, long long n_nodes){
+        std::string name = new_name();
+        if(n_nodes <= 1){
+            lines.push_back(name + ": " + std::to_string(value));
+            return name;
+        }
+        long long n_left  = 2*random_int(rng,0,(n_nodes-3)/2) + 1;
+        long long n_right = n_nodes - 1 - n_left;
+        long long left, right;
+        char operation;
+        std::vector<char> options = {'-'};
+        if(value >= 2){ options.push_back('+'); }
+        if(value < 1000000000LL){ options.push_back('/'); }
+        for(int f = 2; f<=9; f++){
+            if(value % f == 0 && value > f){ options.push_back('*'); break; }
+        }
+        operation = options[random_int(rng,0,options.size()-1)];
+        switch(operation){
+            case '+':
+                left  = random_int(rng,1,value-1);
+                right = value - left;
+                break;
+            case '-':
+                right = random_int(rng,1,1000);
+                left  = value + right;
+                break;
+            case '/':
+                right = random_int(rng,2,5);
+                left  = value*right;
+                break;
+            default:
+                right = 9;
+                while(value % right != 0 || right >= value){ right--; }
+                left  = value/right;
+                break;
+        }
+        std::string left_name  = expression(left,n_left);
+        std::string right_name = expression(right,n_right);
+        lines.push_back(name + ": " + left_name + " " + operation + " " + right_name);
+        return name;
+    };
+
+    //The spine: from humn up to the left child of root. The value of the
+    //spine for the solution humn_value is tracked, as well as the slope.
+    long long humn_value = random_int(rng,1000000000000LL,9000000000000LL);
+    long long n_remaining = std::max(size,9LL) - 3;
+    long long spine_length = std::clamp(n_remaining/10,1LL,5000LL);
+    long long branch_size  = std::max(1LL,(n_remaining/spine_length - 1) | 1);
+    std::string current = "humn";
+    long long value = humn_value;
+    long long slope = 1;
+    for(long long level = 0; level<spine_length; level++){
+        std::string name = new_name();
+        double choice = random_real(rng);
+        if(choice < 0.1 && std::abs(slope) < 32 && value < 100000000000000LL){
+            long long factor = random_int(rng,2,4);
+            std::string other = expression(factor,1);
+            lines.push_back(name + ": " + (random_int(rng,0,1) ? current + " * " + other : other + " * " + current));
+            value *= factor;
+            slope *= factor;
+        }else if(choice < 0.5 && value > 100000){
+            long long constant = random_int(rng,1,std::min(value-1,100000LL));
+            std::string other = expression(constant,branch_size);
+            lines.push_back(name + ": " + current + " - " + other);
+            value -= constant;
+        }else{
+            long long constant = random_int(rng,1,100000);
+            std::string other = expression(constant,branch_size);
+            lines.push_back(name + ": " + (random_int(rng,0,1) ? current + " + " + other : other + " + " + current));
+            value += constant;
+        }
+        current = name;
+    }
+
+    //Root compares both sides in part 2, so the other side equals the spine
+    std::string other = expression(value,branch_size);
+    lines.push_back("root: " + current + " + " + other);
+
+    //In part 1, humn yells some other number
+    lines.push_back("humn: " + std::to_string(random_int(rng,1,1000)));
+
+    std::shuffle(lines.begin(),lines.end(),rng);
+    for(const auto& line : lines){
+        out << line << "\n";
+    }
+}
+
+//Puzzle 22: size = face size of the cube. The net is one of a few layouts
+//that fit within a 4x4 grid of faces.
+void generate_puzzle22(std::ostream& out, long long size, rng_type& rng){
+    const int face_size = std::clamp(size,2LL,2000LL);
+    const std::vector<std::vector<std::pair<int,int>>> layouts = {
+        {{0,2},{1,0},{1,1},{1,2},{2,2},{2,3}},  //Example layout
+        {{0,1},{0,2},{1,1},{2,0},{2,1},{3,0}},  //Common real input layout
+        {{0,1},{1,0},{1,1},{1,2},{1,3},{2,1}},  //Cross
+        {{0,0},{0,1},{1,1},{1,2},{2,2},{2,3}},  //Staircase
+    };
+    const auto& layout = layouts[random_int(rng,0,layouts.size()-1)];
+    std::set<std::pair<int,int>> faces(layout.begin(),layout.end());
+    int n_face_rows = 0;
+    for(const auto& face : layout){
+        n_face_rows = std::max(n_face_rows,face.first+1);
+    }
+
+    bool first_tile = true;
+    for(int row = 0; row<n_face_rows*face_size; row++){
+        //Faces in this row, trailing spaces are omitted
+        int last_col = 0;
+        for(const auto& face : faces){
+            if(face.first == row/face_size){
+                last_col = std::max(last_col,(face.second+1)*face_size);
+            }
+        }
+        std::string line(last_col,' ');
+        for(int col = 0; col<last_col; col++){
+            if(faces.count({row/face_size,col/face_size})){
+                //The start position is never a wall
+                line[col] = (!first_tile && random_real(rng) < 0.1) ? '#' : '.';
+                first_tile = false;
+            }
+        }
+        out << line << "\n";
+    }
+    out << "\n";
+
+    int n_instructions = 80*face_size;
+    for(int i = 0; i<n_instructions; i++){
+        out << random_int(rng,1,50) << ((i == n_instructions-1) ? "" : (random_int(rng,0,1) ? "R" : "L"));
+    }
+    out << "\n";
+}
+
+//Generator registry
+struct Generator{
+    std::string puzzle;
+    std::string size_description;
+    long long default_size;
+    std::function<void(std::ostream&,long long,rng_type&)> generate;
+};
+
+const std::vector<Generator> generators = {
+    {"puzzle1" ,"number of elves"         ,2000   ,generate_puzzle1 },
+    {"puzzle2" ,"number of rounds"        ,2500   ,generate_puzzle2 },
+    {"puzzle3" ,"number of rucksacks"     ,300    ,generate_puzzle3 },
+    {"puzzle4" ,"number of pairs"         ,1000   ,generate_puzzle4 },
+    {"puzzle5" ,"number of moves"         ,500    ,generate_puzzle5 },
+    {"puzzle6" ,"datastream length"       ,4096   ,generate_puzzle6 },
+    {"puzzle7" ,"files and directories"   ,500    ,generate_puzzle7 },
+    {"puzzle8" ,"grid width/height"       ,99     ,generate_puzzle8 },
+    {"puzzle9" ,"number of motions"       ,2000   ,generate_puzzle9 },
+    {"puzzle10","number of instructions"  ,140    ,generate_puzzle10},
+    {"puzzle11","number of items"         ,36     ,generate_puzzle11},
+    {"puzzle12","map width/height"        ,100    ,generate_puzzle12},
+    {"puzzle13","number of packet pairs"  ,150    ,generate_puzzle13},
+    {"puzzle14","number of rock paths"    ,150    ,generate_puzzle14},
+    {"puzzle15","number of sensors"       ,30     ,generate_puzzle15},
+    {"puzzle16","number of valves"        ,60     ,generate_puzzle16},
+    {"puzzle17","jet pattern length"      ,10000  ,generate_puzzle17},
+    {"puzzle18","number of cubes"         ,2500   ,generate_puzzle18},
+    {"puzzle19","number of blueprints"    ,30     ,generate_puzzle19},
+    {"puzzle20","number of values"        ,5000   ,generate_puzzle20},
+    {"puzzle21","number of monkeys"       ,2500   ,generate_puzzle21},
+    {"puzzle22","cube face size"          ,50     ,generate_puzzle22},
+};
+
+void print_usage(){
+    std::cout << "Usage: ./gen_inputs <puzzleN|all> [--size N] [--seed S] [--output <file|dir>]" << std::endl;
+    std::cout << "       ./gen_inputs --list" << std::endl;
+    std::cout << "Writes a synthetic input of the given size to the output file (default: stdout)." << std::endl;
+    std::cout << "With 'all', one input per puzzle (default size, unless --scale is given) is" << std::endl;
+    std::cout << "written to <dir>/puzzleN.txt. --scale F multiplies the default sizes." << std::endl;
+}
+
+//Generate synthetic puzzle inputs
+int main(int argc, char *argv[]){
+    std::string puzzle;
+    long long size   = -1;
+    double    scale  = 1.0;
+    unsigned long long seed = 2022;
+    std::string output;
+    for(int i = 1; i<argc; i++){
+        std::string arg = argv[i];
+        if((arg == "--size" || arg == "--seed" || arg == "--output" || arg == "--scale") && i+1 >= argc){
+            throw std::runtime_error("Missing value for " + arg);
+        }
+        if(arg == "--size"){
+            size = std::stoll(argv[++i]);
+        }else if(arg == "--seed"){
+            seed = std::stoull(argv[++i]);
+        }else if(arg == "--output"){
+            output = argv[++i];
+        }else if(arg == "--scale"){
+            scale = std::stod(argv[++i]);
+        }else if(arg == "--list"){
+            for(const auto& generator : generators){
+                std::cout << generator.puzzle << ": size = " << generator.size_description
+                          << " (default " << generator.default_size << ")" << std::endl;
+            }
+            return 0;
+        }else if(arg == "--help" || arg == "-h"){
+            print_usage();
+            return 0;
+        }else{
+            puzzle = arg;
+        }
+    }
+    if(puzzle.empty()){
+        print_usage();
+        return 1;
+    }
+
+    if(puzzle == "all"){
+        if(output.empty()){
+            throw std::runtime_error("'all' requires an output directory (--output <dir>)");
+        }
+        for(const auto& generator : generators){
+            rng_type rng(seed);
+            std::ofstream out(output + "/" + generator.puzzle + ".txt");
+            if(!out){
+                throw std::runtime_error("Could not write to " + output);
+            }
+            long long puzzle_size = (size > 0) ? size : std::max(1LL,(long long)(generator.default_size*scale));
+            generator.generate(out,puzzle_size,rng);
+        }
+        return 0;
+    }
+
+    auto generator = std::find_if(generators.begin(),generators.end(),[&](const Generator& g){ return g.puzzle == puzzle; });
+    if(generator == generators.end()){
+        throw std::runtime_error("No generator for " + puzzle + " (see --list)");
+    }
+    rng_type rng(seed);
+    long long puzzle_size = (size > 0) ? size : std::max(1LL,(long long)(generator->default_size*scale));
+    if(output.empty()){
+        generator->generate(std::cout,puzzle_size,rng);
+    }else{
+        std::ofstream out(output);
+        if(!out){
+            throw std::runtime_error("Could not write to " + output);
+        }
+        generator->generate(out,puzzle_size,rng);
+    }
+    return 0;
+}
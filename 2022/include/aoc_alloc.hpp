@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+
+/*
+    Heap allocation tracking. Linking the aoc_alloc library into a puzzle
+    replaces the global operator new / delete by versions that count every
+    allocation (see alloc/alloc.cpp). A summary is printed to stderr at exit.
+
+    aoc::PhaseTimer (aoc_utility.hpp) splits the statistics per phase, so one
+    can check that the solve phase reaches an allocation-free steady state.
+    Phases are tracked per thread, so puzzles that are solved concurrently
+    each get their own statistics (allocations made by the workers of a
+    nested parallel_for count towards the thread that made them).
+    Note that only operator new is tracked: Eigen's dynamic matrices (which
+    use malloc directly) are not counted.
+*/
+namespace aoc::alloc{
+
+    //Allocation statistics, over the whole program or over a single phase
+    struct Statistics{
+        long long allocations = 0;  //Number of allocations
+        long long frees       = 0;  //Number of deallocations
+        long long bytes       = 0;  //Number of bytes allocated
+        long long peak        = 0;  //Peak live heap (bytes)
+        long long live        = 0;  //Live heap at the end (bytes)
+    };
+
+    //Statistics since the start of the program
+    Statistics total();
+
+    //End the current phase of the calling thread (the first phase starts
+    //when the thread starts) and start the next one. Only the allocations
+    //made by the calling thread count, and the peak is the peak of the
+    //bytes it allocated minus the bytes it freed. The name must be a string
+    //literal.
+    Statistics end_phase(const char* name);
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <memory_resource>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+
+/*
+    Bump allocator for structures that are built once and thrown away as a
+    whole (node graphs, parse trees, lookup tables of a single solve).
+
+    Memory is handed out from large chunks by advancing a pointer, so nodes
+    that are allocated one after the other end up next to each other, and
+    deallocation does nothing: all memory is returned at once when the arena
+    is released or destroyed. The arena is a std::pmr::memory_resource, so it
+    works with all std::pmr containers:
+
+        aoc::Arena arena;
+        std::pmr::vector<Node> nodes(&arena);
+        std::pmr::unordered_map<int,Node*> map(&arena);
+        int* row = arena.allocate_array<int>(n);    //Zero-initialized
+
+    An arena is not thread safe: use one arena per thread (or per task).
+    Note that copying a std::pmr container does not copy its resource (the
+    copy uses the default resource), while moving it does.
+*/
+namespace aoc{
+
+    class Arena : public std::pmr::memory_resource{
+    public:
+        //The first chunk has (at least) first_chunk bytes, every next chunk is
+        //twice as large. The chunks themselves come from upstream.
+        explicit Arena(size_t first_chunk = 4096,
+                       std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+            : next_chunk_size(std::max<size_t>(first_chunk,256)), upstream(upstream){}
+
+        ~Arena(){
+            release();
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        //Storage for n value-initialized (zero for numbers) objects of type T.
+        //T must be trivially destructible, since the arena never runs destructors.
+        template<typename T>
+        T* allocate_array(size_t n){
+            static_assert(std::is_trivially_destructible_v<T>, "The arena never destroys its objects");
+            T* array = static_cast<T*>(allocate(n*sizeof(T),alignof(T)));
+            std::uninitialized_value_construct_n(array,n);
+            return array;
+        }
+
+        //Return all chunks to the upstream resource. Everything allocated
+        //from the arena becomes invalid.
+        void release(){
+            while(chunks != nullptr){
+                Chunk* next = chunks->next;
+                upstream->deallocate(chunks,chunks->size,alignof(Chunk));
+                chunks = next;
+            }
+            current = nullptr;
+            end     = nullptr;
+            used    = 0;
+        }
+
+        //Number of bytes handed out (including alignment padding)
+        size_t bytes_used() const{
+            return used;
+        }
+
+    private:
+        //Every chunk starts with this header
+        struct alignas(std::max_align_t) Chunk{
+            Chunk* next;
+            size_t size;
+        };
+
+        void* do_allocate(size_t bytes, size_t alignment) override{
+            uintptr_t start   = reinterpret_cast<uintptr_t>(current);
+            uintptr_t aligned = (start + alignment - 1) & ~uintptr_t(alignment - 1);
+            if(current == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(end)){
+                new_chunk(bytes + alignment);
+                start   = reinterpret_cast<uintptr_t>(current);
+                aligned = (start + alignment - 1) & ~uintptr_t(alignment - 1);
+            }
+            current = reinterpret_cast<char*>(aligned + bytes);
+            used   += aligned + bytes - start;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        //Memory is only returned by release
+        void do_deallocate(void*, size_t, size_t) override{}
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override{
+            return this == &other;
+        }
+
+        //Start a new chunk with room for at least bytes
+        void new_chunk(size_t bytes){
+            size_t size = std::max(next_chunk_size,bytes + sizeof(Chunk));
+            Chunk* chunk = static_cast<Chunk*>(upstream->allocate(size,alignof(Chunk)));
+            chunk->next = chunks;
+            chunk->size = size;
+            chunks  = chunk;
+            current = reinterpret_cast<char*>(chunk + 1);
+            end     = reinterpret_cast<char*>(chunk) + size;
+            next_chunk_size = size*2;
+        }
+
+        size_t next_chunk_size;
+        std::pmr::memory_resource* upstream;
+        Chunk* chunks  = nullptr;   //Most recent chunk first
+        char*  current = nullptr;   //Next free byte in the current chunk
+        char*  end     = nullptr;   //End of the current chunk
+        size_t used    = 0;
+    };
+}
\ No newline at end of file
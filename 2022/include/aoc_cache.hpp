@@ -0,0 +1,186 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <system_error>
+#include "aoc_hash.hpp"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/*
+    On-disk cache of puzzle results. The output of a solve is stored under a
+    key made of the puzzle, the part, a hash of the solver build (the running
+    executable) and a hash of the input bytes. A rebuilt solver or a changed
+    input therefore never returns a stale answer.
+
+        aoc::ResultCache cache(aoc::ResultCache::default_directory());
+        std::string key = aoc::ResultCache::key("puzzle16",2,input.data());
+        std::string output;
+        if(!cache.lookup(key,output)){
+            ...solve, write the output to output...
+            cache.store(key,output);
+        }
+
+    The cache is a plain directory with one file per result. Files are written
+    to a temporary name and renamed, so concurrent processes never see partial
+    results. When the total size exceeds the limit, the least recently used
+    results are removed. Errors of the cache itself (e.g. a read-only
+    directory) are ignored: the puzzle is then simply solved.
+*/
+namespace aoc{
+
+    class ResultCache{
+    public:
+        //Default size limit of the cache directory
+        static constexpr uintmax_t default_max_bytes = 64 << 20;
+
+        explicit ResultCache(std::filesystem::path directory, uintmax_t max_bytes = default_max_bytes)
+            : directory(std::move(directory)), max_bytes(max_bytes){}
+
+        //The cache directory: AOC_CACHE_DIR if set, otherwise aoc_2022 in the
+        //user's cache directory (XDG_CACHE_HOME or ~/.cache)
+        static std::filesystem::path default_directory(){
+            if(const char* dir = std::getenv("AOC_CACHE_DIR")){
+                return dir;
+            }
+            if(const char* dir = std::getenv("XDG_CACHE_HOME")){
+                return std::filesystem::path(dir) / "aoc_2022";
+            }
+            if(const char* home = std::getenv("HOME")){
+                return std::filesystem::path(home) / ".cache" / "aoc_2022";
+            }
+            return std::filesystem::temp_directory_path() / "aoc_2022";
+        }
+
+        //The size limit: AOC_CACHE_SIZE_MB if set, otherwise default_max_bytes
+        static uintmax_t default_size(){
+            if(const char* size = std::getenv("AOC_CACHE_SIZE_MB")){
+                return uintmax_t(std::max(1,std::atoi(size))) << 20;
+            }
+            return default_max_bytes;
+        }
+
+        //Hash of the running executable, so results of another build of the
+        //solvers are never used. Computed once per process.
+        static uint64_t build_hash(){
+            static const uint64_t hash = [](){
+            #ifdef __linux__
+                std::ifstream exe("/proc/self/exe",std::ios::binary);
+                if(exe){
+                    std::ostringstream contents;
+                    contents << exe.rdbuf();
+                    return hash64(contents.str());
+                }
+            #endif
+                //No access to the executable: fall back to the build time of
+                //this translation unit
+                return hash64(__DATE__ " " __TIME__);
+            }();
+            return hash;
+        }
+
+        //The cache key of a puzzle part (1, 2 or 0 for all parts) for the given input
+        static std::string key(const std::string& puzzle, int part, std::string_view input){
+            std::ostringstream key;
+            key << puzzle << "-" << (part == 0 ? std::string("all") : std::to_string(part)) << "-"
+                << std::hex << std::setfill('0') << std::setw(16) << build_hash() << "-"
+                << std::setw(16) << hash64(input);
+            return key.str();
+        }
+
+        //Look up a stored result. Returns false if there is none.
+        bool lookup(const std::string& key, std::string& output) const{
+            std::ifstream file(directory / key,std::ios::binary);
+            if(!file){
+                return false;
+            }
+            std::ostringstream contents;
+            contents << file.rdbuf();
+            output = contents.str();
+
+            //Mark the result as recently used
+            std::error_code error;
+            std::filesystem::last_write_time(directory / key,std::filesystem::file_time_type::clock::now(),error);
+            return true;
+        }
+
+        //Store a result, and evict the least recently used results if the
+        //cache grew too large
+        void store(const std::string& key, const std::string& output) const{
+            std::error_code error;
+            std::filesystem::create_directories(directory,error);
+
+            //Write to a name that is unique to this process and call, then
+            //move it into place (atomically)
+            static std::atomic<int> counter{0};
+            std::filesystem::path temporary = directory / (".tmp-" + key + "-" + std::to_string(process_id()) + "-" + std::to_string(counter++));
+            {
+                std::ofstream file(temporary,std::ios::binary);
+                if(!file || !file.write(output.data(),output.size())){
+                    std::filesystem::remove(temporary,error);
+                    return;
+                }
+            }
+            std::filesystem::rename(temporary,directory / key,error);
+            if(error){
+                std::filesystem::remove(temporary,error);
+                return;
+            }
+            evict();
+        }
+
+    private:
+        static long process_id(){
+        #ifdef _WIN32
+            return 0;
+        #else
+            return ::getpid();
+        #endif
+        }
+
+        //Remove the least recently used results until the cache fits
+        void evict() const{
+            struct Entry{
+                std::filesystem::file_time_type time;
+                uintmax_t size;
+                std::filesystem::path path;
+            };
+            std::vector<Entry> entries;
+            uintmax_t total = 0;
+            std::error_code error;
+            for(std::filesystem::directory_iterator it(directory,error), end; !error && it != end; it.increment(error)){
+                std::error_code entry_error;
+                uintmax_t size = it->file_size(entry_error);
+                auto time = it->last_write_time(entry_error);
+                if(!entry_error && it->is_regular_file(entry_error)){
+                    entries.push_back({time,size,it->path()});
+                    total += size;
+                }
+            }
+            if(total <= max_bytes){
+                return;
+            }
+            std::sort(entries.begin(),entries.end(),[](const Entry& a, const Entry& b){ return a.time < b.time; });
+            for(const auto& entry : entries){
+                if(total <= max_bytes){
+                    break;
+                }
+                if(std::filesystem::remove(entry.path,error)){
+                    total -= entry.size;
+                }
+            }
+        }
+
+        std::filesystem::path directory;
+        uintmax_t max_bytes;
+    };
+}
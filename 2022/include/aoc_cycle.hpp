@@ -0,0 +1,188 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <type_traits>
+#include <cstring>
+#include "aoc_hash.hpp"
+
+/*
+    Cycle detection for simulations that have to be extrapolated far beyond
+    what can be simulated (e.g. 10^12 steps). The state after every step is
+    added together with a value (a height, a score, ...). Once a state
+    repeats, the value of any later step follows from the values within one
+    period:
+
+        aoc::CycleDetector<State> cycle;
+        for(long long step = 0; !cycle.found(); step++){
+            ...simulate one step...
+            cycle.add(state,value);
+        }
+        long long answer = cycle.value_at(1000000000000-1);
+
+    The state must be a fixed-size type without padding bytes (integers, and
+    structs or arrays of them), since states are hashed and compared by their
+    bytes. There are two modes:
+     - table: every state is stored in a hash table. Finds the first
+       repetition, so cycle_start() is the real start of the cycle.
+     - brent: Brent's algorithm, which stores a single state. Needs up to a
+       few periods more steps to detect the cycle, and cycle_start() may lie
+       somewhere after the real start (but always within the cycle). Only
+       the values since the saved state are kept (the current power of two
+       window, O(max(tail,period)) values), which is all the extrapolation
+       needs. The values of earlier steps are no longer available.
+    In table mode the values of all steps are kept.
+*/
+namespace aoc{
+
+    enum class CycleMode{
+        table,
+        brent
+    };
+
+    template<typename State>
+    class CycleDetector{
+        static_assert(std::has_unique_object_representations_v<State>, "State must not have padding bytes");
+
+    public:
+        explicit CycleDetector(CycleMode mode = CycleMode::table) : mode(mode){}
+
+        //Add the state after the next step (the first call is step 0), and
+        //the value at that step. Returns true once a cycle was found, after
+        //which further states are ignored.
+        bool add(const State& state, long long value){
+            if(found()){
+                return true;
+            }
+            const long long step = n_steps++;
+            values.push_back(value);
+
+            if(mode == CycleMode::table){
+                auto [it,inserted] = seen.try_emplace(state,step);
+                if(!inserted){
+                    start     = it->second;
+                    cycle_len = step - it->second;
+                }
+            }else{
+                //The saved state is compared to every next state. It is
+                //replaced after 1, 2, 4, 8... steps, so once the saved state
+                //lies within the cycle and the power reaches the period, the
+                //saved state comes back.
+                if(step > 0 && equal(state,saved)){
+                    start     = saved_step;
+                    cycle_len = step - saved_step;
+                }else if(step == 0 || step - saved_step == power){
+                    saved      = state;
+                    saved_step = step;
+                    power     *= (step == 0) ? 1 : 2;
+                    //A cycle found later starts at the saved step, so the
+                    //values before it are not needed anymore
+                    values.erase(values.begin(),values.end()-1);
+                    first_kept = step;
+                }
+            }
+            return found();
+        }
+
+        bool found() const{
+            return cycle_len > 0;
+        }
+
+        //Number of steps added so far
+        long long steps() const{
+            return n_steps;
+        }
+
+        //First step of the cycle: the state at cycle_start() + period() is the
+        //same as at cycle_start()
+        long long cycle_start() const{
+            require_cycle();
+            return start;
+        }
+
+        //Number of steps in one cycle
+        long long period() const{
+            require_cycle();
+            return cycle_len;
+        }
+
+        //Change of the value over one period
+        long long delta() const{
+            require_cycle();
+            return value(start + cycle_len) - value(start);
+        }
+
+        //Change of the value in each step of one period (starting from the
+        //step after cycle_start()). These add up to delta().
+        std::vector<long long> deltas() const{
+            require_cycle();
+            std::vector<long long> result(cycle_len);
+            for(long long i = 0; i<cycle_len; i++){
+                result[i] = value(start + i + 1) - value(start + i);
+            }
+            return result;
+        }
+
+        //The value at any step: directly for the steps that were added,
+        //extrapolated from the cycle for the later steps. In brent mode, the
+        //steps before the saved state are not available.
+        long long value_at(long long step) const{
+            if(step < 0){
+                throw std::runtime_error("Negative step " + std::to_string(step));
+            }
+            if(step < first_kept){
+                throw std::runtime_error("The value of step " + std::to_string(step) + " is not kept (the first kept step is "
+                                         + std::to_string(first_kept) + ")");
+            }
+            if(step < steps()){
+                return value(step);
+            }
+            require_cycle();
+            const long long repeats = (step - start) / cycle_len;
+            return value(start + (step - start) % cycle_len) + repeats*delta();
+        }
+
+    private:
+        struct Hash{
+            size_t operator()(const State& state) const{
+                return hash_object(state);
+            }
+        };
+        struct Equal{
+            bool operator()(const State& a, const State& b) const{
+                return equal(a,b);
+            }
+        };
+
+        //Value of a step that is kept
+        long long value(long long step) const{
+            return values[step - first_kept];
+        }
+
+        static bool equal(const State& a, const State& b){
+            return std::memcmp(&a,&b,sizeof(State)) == 0;
+        }
+
+        void require_cycle() const{
+            if(!found()){
+                throw std::runtime_error("No cycle found after " + std::to_string(steps()) + " steps");
+            }
+        }
+
+        CycleMode mode;
+        std::vector<long long> values;          //Value at every kept step
+        long long first_kept = 0;               //Step of values[0]
+        long long n_steps    = 0;
+        long long start     = 0;
+        long long cycle_len = 0;                //0 while no cycle was found
+
+        //Table mode: the first step at which each state was seen
+        std::unordered_map<State,long long,Hash,Equal> seen;
+
+        //Brent mode: the saved state, the step it was saved at, and the
+        //number of steps until it is replaced
+        State saved{};
+        long long saved_step = 0;
+        long long power      = 1;
+    };
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <type_traits>
+#include <stdexcept>
+#include <string>
+
+/*
+    Hash map and hash set for integer keys, with open addressing (linear
+    probing) in a single flat array. Compared to std::unordered_map, there is
+    no allocation per element and a lookup touches one or two cache lines.
+    Coordinates are packed into a single 64-bit key:
+
+        aoc::FlatSet<uint64_t> visited;
+        visited.insert(aoc::pack_xy(x,y));
+
+        aoc::FlatMap<int,Node*> nodes;
+        nodes[id] = &node;
+        if(Node** node = nodes.find(id)){ ... }
+        nodes.for_each([](int id, Node* node){ ... });
+
+    Other small keys (e.g. a pair of an id and a name) need a hash function
+    of their own, and are compared with operator==:
+
+        aoc::FlatMap<std::pair<int,std::string_view>,int,PairHash> ids;
+
+    Elements can not be erased. Inserting may move all elements, so pointers
+    to values are only valid until the next insert. The iteration order is
+    unspecified (but deterministic).
+*/
+namespace aoc{
+
+    //Fast mixing of an integer (the finalizer of MurmurHash3), so that keys
+    //that differ only in a few (high) bits end up in different buckets
+    inline uint64_t hash_int(uint64_t x){
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    //Pack a 2D coordinate into a single key (any 32 bit values)
+    inline uint64_t pack_xy(int32_t x, int32_t y){
+        return (uint64_t(uint32_t(x)) << 32) | uint32_t(y);
+    }
+
+    //Pack a 3D coordinate into a single key. Each coordinate must lie in
+    //[-2^20,2^20).
+    inline uint64_t pack_xyz(int32_t x, int32_t y, int32_t z){
+        constexpr uint64_t mask = (uint64_t(1) << 21) - 1;
+        return ((uint64_t(uint32_t(x)) & mask) << 42) | ((uint64_t(uint32_t(y)) & mask) << 21) | (uint64_t(uint32_t(z)) & mask);
+    }
+
+    //Default hash of the keys of FlatMap and FlatSet
+    template<typename Key>
+    struct FlatHash{
+        static_assert(std::is_integral_v<Key>, "Keys that are not integers need a hash of their own (or see pack_xy)");
+
+        uint64_t operator()(Key key) const{
+            return hash_int(static_cast<uint64_t>(key));
+        }
+    };
+
+    template<typename Key, typename Value, typename Hash = FlatHash<Key>>
+    class FlatMap{
+    public:
+        //Reserve room for expected elements
+        explicit FlatMap(size_t expected = 0){
+            reserve(expected);
+        }
+
+        size_t size() const{
+            return count;
+        }
+
+        bool empty() const{
+            return count == 0;
+        }
+
+        //Remove all elements (but keep the storage)
+        void clear(){
+            for(auto& slot : slots){
+                slot.used = false;
+            }
+            count = 0;
+        }
+
+        //Make room for n elements without growing
+        void reserve(size_t n){
+            size_t capacity = 16;
+            while(capacity*max_load_num < n*max_load_den){
+                capacity *= 2;
+            }
+            if(capacity > slots.size()){
+                rehash(capacity);
+            }
+        }
+
+        //Pointer to the value of key, or nullptr if key is not present
+        Value* find(Key key){
+            if(slots.empty()){
+                return nullptr;
+            }
+            size_t i = slot_index(key);
+            while(slots[i].used){
+                if(slots[i].key == key){
+                    return &slots[i].value;
+                }
+                i = (i + 1) & mask;
+            }
+            return nullptr;
+        }
+
+        const Value* find(Key key) const{
+            return const_cast<FlatMap*>(this)->find(key);
+        }
+
+        bool contains(Key key) const{
+            return find(key) != nullptr;
+        }
+
+        Value& at(Key key){
+            Value* value = find(key);
+            if(value == nullptr){
+                if constexpr(std::is_integral_v<Key>){
+                    throw std::runtime_error("Key " + std::to_string(key) + " not found");
+                }else{
+                    throw std::runtime_error("Key not found");
+                }
+            }
+            return *value;
+        }
+
+        const Value& at(Key key) const{
+            return const_cast<FlatMap*>(this)->at(key);
+        }
+
+        //Insert key with value if it is not present yet. Returns the value of
+        //key, and whether it was inserted.
+        std::pair<Value*,bool> try_emplace(Key key, Value value = Value()){
+            if((count + 1)*max_load_den > slots.size()*max_load_num){
+                rehash(std::max<size_t>(16,slots.size()*2));
+            }
+            size_t i = slot_index(key);
+            while(slots[i].used){
+                if(slots[i].key == key){
+                    return {&slots[i].value,false};
+                }
+                i = (i + 1) & mask;
+            }
+            slots[i].used  = true;
+            slots[i].key   = key;
+            slots[i].value = std::move(value);
+            count++;
+            return {&slots[i].value,true};
+        }
+
+        //The value of key, inserted (value-initialized) if not present
+        Value& operator[](Key key){
+            return *try_emplace(key).first;
+        }
+
+        //Call f(key,value) for every element
+        template<typename F>
+        void for_each(const F& f){
+            for(auto& slot : slots){
+                if(slot.used){
+                    f(slot.key,slot.value);
+                }
+            }
+        }
+
+        template<typename F>
+        void for_each(const F& f) const{
+            for(const auto& slot : slots){
+                if(slot.used){
+                    f(slot.key,slot.value);
+                }
+            }
+        }
+
+    private:
+        //The table is grown when it would get more than 3/4 full
+        static constexpr size_t max_load_num = 3;
+        static constexpr size_t max_load_den = 4;
+
+        struct Slot{
+            Key   key{};
+            bool  used = false;
+            Value value{};
+        };
+
+        size_t slot_index(const Key& key) const{
+            return Hash()(key) & mask;
+        }
+
+        //Move all elements into a table of the given (power of 2) capacity
+        void rehash(size_t capacity){
+            std::vector<Slot> old(capacity);
+            old.swap(slots);
+            mask = capacity - 1;
+            for(auto& slot : old){
+                if(!slot.used){
+                    continue;
+                }
+                size_t i = slot_index(slot.key);
+                while(slots[i].used){
+                    i = (i + 1) & mask;
+                }
+                slots[i] = std::move(slot);
+            }
+        }
+
+        std::vector<Slot> slots;
+        size_t mask  = 0;
+        size_t count = 0;
+    };
+
+    template<typename Key, typename Hash = FlatHash<Key>>
+    class FlatSet{
+    public:
+        explicit FlatSet(size_t expected = 0) : map(expected){}
+
+        size_t size() const{
+            return map.size();
+        }
+
+        bool empty() const{
+            return map.empty();
+        }
+
+        void clear(){
+            map.clear();
+        }
+
+        void reserve(size_t n){
+            map.reserve(n);
+        }
+
+        //Insert key. Returns false if it was already present.
+        bool insert(Key key){
+            return map.try_emplace(key).second;
+        }
+
+        bool contains(Key key) const{
+            return map.contains(key);
+        }
+
+        //Call f(key) for every element
+        template<typename F>
+        void for_each(const F& f) const{
+            map.for_each([&](Key key, Empty){ f(key); });
+        }
+
+    private:
+        struct Empty{};
+        FlatMap<Key,Empty,Hash> map;
+    };
+}
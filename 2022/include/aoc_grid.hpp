@@ -0,0 +1,310 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+
+/*
+    A dense N-dimensional grid, for the many puzzles that work on a map.
+
+    The cells are stored in one contiguous block, in row-major order (the last
+    coordinate is contiguous). The grid can have a border of extra cells around
+    it: coordinates then run from -border to extent+border-1. A border filled
+    with a sentinel value (a wall, or empty space) means that neighbours can be
+    looked up without bounds checks.
+
+    Cells are addressed with coordinates, or with a flat index into the storage.
+    Moving to a neighbour is then a matter of adding an offset:
+
+        auto map = aoc::Grid<char>::from_text(input.data(), 1, '#');
+        for(auto offset : map.neighbour_offsets()){
+            char neighbour = map[index + offset];
+        }
+
+    Rows and columns of a 2D grid can be accessed as (strided) spans with
+    row(r) and column(c).
+*/
+namespace aoc{
+
+    //A view on a strided sequence of grid cells (a row or a column)
+    template<typename T>
+    class GridSpan{
+    public:
+        class iterator{
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = std::remove_const_t<T>;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = T*;
+            using reference         = T&;
+
+            iterator(T* ptr, std::ptrdiff_t stride) : ptr(ptr), stride(stride){}
+
+            T& operator*() const{ return *ptr; }
+            T& operator[](std::ptrdiff_t n) const{ return ptr[n*stride]; }
+            iterator& operator++(){ ptr += stride; return *this; }
+            iterator& operator--(){ ptr -= stride; return *this; }
+            iterator operator++(int){ iterator old = *this; ptr += stride; return old; }
+            iterator operator--(int){ iterator old = *this; ptr -= stride; return old; }
+            iterator& operator+=(std::ptrdiff_t n){ ptr += n*stride; return *this; }
+            iterator& operator-=(std::ptrdiff_t n){ ptr -= n*stride; return *this; }
+            iterator operator+(std::ptrdiff_t n) const{ return iterator(ptr + n*stride,stride); }
+            iterator operator-(std::ptrdiff_t n) const{ return iterator(ptr - n*stride,stride); }
+            std::ptrdiff_t operator-(const iterator& other) const{ return (ptr - other.ptr)/stride; }
+            bool operator==(const iterator& other) const{ return ptr == other.ptr; }
+            bool operator!=(const iterator& other) const{ return ptr != other.ptr; }
+            bool operator<(const iterator& other) const{ return (*this - other) < 0; }
+
+        private:
+            T* ptr;
+            std::ptrdiff_t stride;
+        };
+
+        GridSpan(T* first, std::ptrdiff_t stride, int length) : first(first), stride(stride), length(length){}
+
+        int size() const{ return length; }
+        T& operator[](int i) const{ return first[i*stride]; }
+        iterator begin() const{ return iterator(first,stride); }
+        iterator end() const{ return iterator(first + length*stride,stride); }
+
+    private:
+        T* first;
+        std::ptrdiff_t stride;
+        int length;
+    };
+
+    template<typename T, size_t Dims = 2>
+    class Grid{
+        //std::vector<bool> is not contiguous, use char instead
+        static_assert(!std::is_same<T,bool>::value, "aoc::Grid<bool> is not supported, use char");
+        static_assert(Dims > 0, "aoc::Grid needs at least one dimension");
+
+    public:
+        using coord_type = std::array<int,Dims>;
+        using index_type = std::ptrdiff_t;
+
+        Grid() = default;
+
+        //Grid with the given extent (number of cells in every dimension),
+        //surrounded by a border of the given width
+        explicit Grid(const coord_type& extent, int border = 0, const T& value = T{}, const T& border_value = T{})
+            : extents(extent), border_width(border){
+            size_t n_cells = 1;
+            for(size_t d = Dims; d-- > 0;){
+                if(extents[d] < 0 || border_width < 0){
+                    throw std::runtime_error("Invalid grid size");
+                }
+                strides[d] = n_cells;
+                n_cells   *= extents[d] + 2*border_width;
+            }
+            origin = 0;
+            for(size_t d = 0; d<Dims; d++){
+                origin += border_width*strides[d];
+            }
+            cells.assign(n_cells,border_value);
+            fill(value);
+        }
+
+        //Character grid from text: one row per line. The number of columns is
+        //the length of the longest line; shorter lines are padded with fill.
+        static Grid from_text(std::string_view text, int border = 0, const T& border_value = T{}, const T& fill = T{}){
+            static_assert(Dims == 2, "from_text creates a 2D grid");
+            if(!text.empty() && text.back() == '\n'){
+                text.remove_suffix(1);
+            }
+            int n_rows = 0;
+            int n_cols = 0;
+            for(size_t start = 0; start <= text.size() && !text.empty();){
+                size_t end = std::min(text.find('\n',start),text.size());
+                n_cols = std::max<int>(n_cols,end - start);
+                n_rows++;
+                start = end + 1;
+            }
+            Grid grid({n_rows,n_cols},border,fill,border_value);
+            int row = 0;
+            for(size_t start = 0; start <= text.size() && !text.empty(); row++){
+                size_t end = std::min(text.find('\n',start),text.size());
+                for(size_t i = start; i<end; i++){
+                    grid(row,static_cast<int>(i - start)) = T(text[i]);
+                }
+                start = end + 1;
+            }
+            return grid;
+        }
+
+        //Number of cells in dimension d (without the border)
+        int extent(size_t d) const{ return extents[d]; }
+        const coord_type& extent() const{ return extents; }
+        int rows() const{ return extents[0]; }
+        int cols() const{ static_assert(Dims >= 2, "cols() needs a 2D grid"); return extents[1]; }
+        int border() const{ return border_width; }
+
+        //Distance between neighbouring cells in dimension d, in the flat storage
+        index_type stride(size_t d) const{ return strides[d]; }
+
+        //Number of cells, without and with the border
+        size_t size() const{
+            size_t n = 1;
+            for(int e : extents){
+                n *= e;
+            }
+            return n;
+        }
+        size_t storage_size() const{ return cells.size(); }
+
+        T* data(){ return cells.data(); }
+        const T* data() const{ return cells.data(); }
+
+        //Flat index of a cell
+        template<typename... Coords>
+        index_type index(Coords... coords) const{
+            static_assert(sizeof...(Coords) == Dims, "Number of coordinates does not match the grid dimension");
+            index_type result = origin;
+            size_t d = 0;
+            ((result += static_cast<index_type>(coords)*strides[d++]), ...);
+            return result;
+        }
+        index_type index(const coord_type& coords) const{
+            index_type result = origin;
+            for(size_t d = 0; d<Dims; d++){
+                result += static_cast<index_type>(coords[d])*strides[d];
+            }
+            return result;
+        }
+
+        //Coordinates of a flat index
+        coord_type coords(index_type index) const{
+            coord_type result;
+            for(size_t d = 0; d<Dims; d++){
+                result[d] = static_cast<int>(index/strides[d]) - border_width;
+                index    %= strides[d];
+            }
+            return result;
+        }
+
+        template<typename... Coords>
+        T& operator()(Coords... coords){ return cells[index(coords...)]; }
+        template<typename... Coords>
+        const T& operator()(Coords... coords) const{ return cells[index(coords...)]; }
+        T& operator()(const coord_type& coords){ return cells[index(coords)]; }
+        const T& operator()(const coord_type& coords) const{ return cells[index(coords)]; }
+
+        //Access by flat index
+        T& operator[](index_type index){ return cells[index]; }
+        const T& operator[](index_type index) const{ return cells[index]; }
+
+        //True if the coordinates are inside the grid (not in the border)
+        template<typename... Coords>
+        bool in_bounds(Coords... coords) const{
+            static_assert(sizeof...(Coords) == Dims, "Number of coordinates does not match the grid dimension");
+            size_t d = 0;
+            return ((static_cast<int>(coords) >= 0 && static_cast<int>(coords) < extents[d++]) && ...);
+        }
+        bool in_bounds(const coord_type& coords) const{
+            for(size_t d = 0; d<Dims; d++){
+                if(coords[d] < 0 || coords[d] >= extents[d]){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //Set all cells (not the border) to value
+        void fill(const T& value){
+            for_each_cell([&](index_type index){ cells[index] = value; });
+        }
+
+        //Set all border cells to value
+        void fill_border(const T& value){
+            if(border_width == 0){
+                return;
+            }
+            for(index_type index = 0; index<static_cast<index_type>(cells.size()); index++){
+                if(!in_bounds(coords(index))){
+                    cells[index] = value;
+                }
+            }
+        }
+
+        //Call f(index) for every cell (not the border), in storage order
+        template<typename F>
+        void for_each_cell(F&& f) const{
+            if(size() == 0){
+                return;
+            }
+            coord_type position{};
+            while(true){
+                index_type first = index(position);
+                for(int i = 0; i<extents[Dims-1]; i++){
+                    f(first + i);
+                }
+                //Advance the outer dimensions, like an odometer
+                size_t d = Dims-1;
+                while(d-- > 0){
+                    if(++position[d] < extents[d]){
+                        break;
+                    }
+                    position[d] = 0;
+                }
+                if(d == static_cast<size_t>(-1)){
+                    return;
+                }
+            }
+        }
+
+        //Flat offsets to the 2*Dims orthogonal neighbours (-x, +x, -y, +y, ...)
+        std::array<index_type,2*Dims> neighbour_offsets() const{
+            std::array<index_type,2*Dims> offsets;
+            for(size_t d = 0; d<Dims; d++){
+                offsets[2*d]   = -strides[d];
+                offsets[2*d+1] =  strides[d];
+            }
+            return offsets;
+        }
+
+        //Flat offsets to all 3^Dims-1 neighbours, including the diagonal ones
+        std::vector<index_type> neighbour_offsets_diagonal() const{
+            std::vector<index_type> offsets{0};
+            for(size_t d = 0; d<Dims; d++){
+                std::vector<index_type> next;
+                for(index_type offset : offsets){
+                    next.push_back(offset - strides[d]);
+                    next.push_back(offset);
+                    next.push_back(offset + strides[d]);
+                }
+                offsets = std::move(next);
+            }
+            offsets.erase(std::find(offsets.begin(),offsets.end(),0));
+            return offsets;
+        }
+
+        //Rows and columns of a 2D grid
+        GridSpan<T> row(int r){
+            static_assert(Dims == 2, "row() needs a 2D grid");
+            return GridSpan<T>(&(*this)(r,0),strides[1],extents[1]);
+        }
+        GridSpan<const T> row(int r) const{
+            static_assert(Dims == 2, "row() needs a 2D grid");
+            return GridSpan<const T>(&(*this)(r,0),strides[1],extents[1]);
+        }
+        GridSpan<T> column(int c){
+            static_assert(Dims == 2, "column() needs a 2D grid");
+            return GridSpan<T>(&(*this)(0,c),strides[0],extents[0]);
+        }
+        GridSpan<const T> column(int c) const{
+            static_assert(Dims == 2, "column() needs a 2D grid");
+            return GridSpan<const T>(&(*this)(0,c),strides[0],extents[0]);
+        }
+
+    private:
+        std::vector<T> cells;               //All cells, including the border
+        coord_type extents{};               //Number of cells in every dimension (without border)
+        std::array<index_type,Dims> strides{};
+        index_type origin = 0;              //Flat index of cell (0,0,...)
+        int border_width = 0;
+    };
+}
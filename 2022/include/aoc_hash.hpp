@@ -0,0 +1,91 @@
+#pragma once
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*
+    Hash functions, for the result cache (aoc_cache.hpp) and the hash tables
+    of the puzzles.
+*/
+namespace aoc{
+
+    //64-bit xxHash (XXH64) of data. Processes 32 bytes per iteration, so
+    //hashing an input is much faster than parsing it.
+    inline uint64_t hash64(std::string_view data, uint64_t seed = 0){
+        constexpr uint64_t P1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t P3 = 0x165667B19E3779F9ULL;
+        constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+        auto rotl = [](uint64_t x, int r){ return (x << r) | (x >> (64 - r)); };
+        auto read64 = [](const char* p){ uint64_t v; std::memcpy(&v,p,8); return v; };
+        auto read32 = [](const char* p){ uint32_t v; std::memcpy(&v,p,4); return v; };
+        auto round = [&](uint64_t acc, uint64_t input){
+            acc += input * P2;
+            return rotl(acc,31) * P1;
+        };
+        auto merge = [&](uint64_t acc, uint64_t value){
+            acc ^= round(0,value);
+            return acc * P1 + P4;
+        };
+
+        const char* p   = data.data();
+        const char* end = p + data.size();
+        uint64_t h;
+        if(data.size() >= 32){
+            //Four independent lanes, to keep the multipliers busy
+            uint64_t v1 = seed + P1 + P2;
+            uint64_t v2 = seed + P2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - P1;
+            for(; p + 32 <= end; p += 32){
+                v1 = round(v1,read64(p));
+                v2 = round(v2,read64(p + 8));
+                v3 = round(v3,read64(p + 16));
+                v4 = round(v4,read64(p + 24));
+            }
+            h = rotl(v1,1) + rotl(v2,7) + rotl(v3,12) + rotl(v4,18);
+            h = merge(h,v1);
+            h = merge(h,v2);
+            h = merge(h,v3);
+            h = merge(h,v4);
+        }else{
+            h = seed + P5;
+        }
+        h += data.size();
+
+        //The remaining 0-31 bytes
+        for(; p + 8 <= end; p += 8){
+            h ^= round(0,read64(p));
+            h  = rotl(h,27) * P1 + P4;
+        }
+        if(p + 4 <= end){
+            h ^= uint64_t(read32(p)) * P1;
+            h  = rotl(h,23) * P2 + P3;
+            p += 4;
+        }
+        for(; p < end; p++){
+            h ^= uint64_t(static_cast<unsigned char>(*p)) * P5;
+            h  = rotl(h,11) * P1;
+        }
+
+        //Final mix
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    //Hash of the bytes of an object. Only for types without padding bytes
+    //(whose value is fully determined by their bytes), such as integers and
+    //structs or arrays of them.
+    template<typename T>
+    uint64_t hash_object(const T& value, uint64_t seed = 0){
+        static_assert(std::has_unique_object_representations_v<T>, "Type must not have padding bytes");
+        return hash64(std::string_view(reinterpret_cast<const char*>(&value),sizeof(T)),seed);
+    }
+}
\ No newline at end of file
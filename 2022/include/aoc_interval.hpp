@@ -0,0 +1,202 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <optional>
+#include <limits>
+#include <stdexcept>
+
+/*
+    A set of integers, stored as sorted, disjoint intervals [first,second]
+    (both ends included). Overlapping and adjacent intervals are merged, so
+    [1,3] and [4,6] become [1,6].
+
+    Intervals can be inserted one by one (insert keeps the set merged), or
+    added in bulk in any order, followed by a single merge:
+
+        aoc::IntervalSet<int> set;
+        for(int row = 0; row<n_rows; row++){
+            set.clear();                //Keeps the storage
+            for(...){
+                set.add(lo,hi);
+            }
+            set.merge();                //Sort and merge in place
+            long long n = set.covered();
+            std::optional<int> gap = set.first_gap(0,4000000);
+        }
+
+    The storage is only ever cleared, never freed, so a set that is reused
+    in a loop stops allocating once it has seen its largest row: the only
+    cost left is the sort. The queries require a merged set.
+*/
+namespace aoc{
+
+    template<typename T = int>
+    class IntervalSet{
+    public:
+        using Interval = std::pair<T,T>;
+
+        IntervalSet() = default;
+
+        //Bulk construction from unsorted (and possibly overlapping) intervals
+        template<typename Iterator>
+        IntervalSet(Iterator begin, Iterator end){
+            assign(begin,end);
+        }
+
+        //Replace the contents by the given unsorted intervals
+        template<typename Iterator>
+        void assign(Iterator begin, Iterator end){
+            clear();
+            for(; begin != end; ++begin){
+                add(begin->first,begin->second);
+            }
+            merge();
+        }
+
+        //Remove all intervals (but keep the storage)
+        void clear(){
+            intervals_.clear();
+            merged = true;
+        }
+
+        void reserve(size_t n){
+            intervals_.reserve(n);
+        }
+
+        //Add an interval without merging. Call merge() before any query.
+        //Empty intervals (lo > hi) are ignored.
+        void add(T lo, T hi){
+            if(lo > hi){
+                return;
+            }
+            intervals_.emplace_back(lo,hi);
+            merged = false;
+        }
+
+        //Sort the intervals and merge the overlapping and adjacent ones, in place
+        void merge(){
+            if(merged){
+                return;
+            }
+            std::sort(intervals_.begin(),intervals_.end());
+            size_t n = 0;
+            for(size_t i = 1; i<intervals_.size(); i++){
+                //Sorted, so interval i does not start before interval n
+                if(!gap_between(intervals_[n].second,intervals_[i].first)){
+                    intervals_[n].second = std::max(intervals_[n].second,intervals_[i].second);
+                }else{
+                    intervals_[++n] = intervals_[i];
+                }
+            }
+            intervals_.resize(intervals_.empty() ? 0 : n+1);
+            merged = true;
+        }
+
+        //Insert an interval, and merge it with the intervals it touches
+        void insert(T lo, T hi){
+            check_merged();
+            if(lo > hi){
+                return;
+            }
+            //The first interval that could touch [lo,hi]: the first that
+            //does not end before lo-1
+            auto first = std::lower_bound(intervals_.begin(),intervals_.end(),lo,[](const Interval& interval, T value){
+                return gap_between(interval.second,value);
+            });
+            auto last = first;
+            Interval merged_interval(lo,hi);
+            while(last != intervals_.end() && touches(merged_interval,*last)){
+                merged_interval.first  = std::min(merged_interval.first,last->first);
+                merged_interval.second = std::max(merged_interval.second,last->second);
+                ++last;
+            }
+            if(first == last){
+                intervals_.insert(first,merged_interval);
+            }else{
+                *first = merged_interval;
+                intervals_.erase(first+1,last);
+            }
+        }
+
+        //The disjoint intervals, in increasing order
+        const std::vector<Interval>& intervals() const{
+            check_merged();
+            return intervals_;
+        }
+
+        //Number of disjoint intervals
+        size_t size() const{
+            check_merged();
+            return intervals_.size();
+        }
+
+        bool empty() const{
+            return intervals_.empty();
+        }
+
+        //Total number of integers in the set
+        long long covered() const{
+            check_merged();
+            long long total = 0;
+            for(const auto& interval : intervals_){
+                total += static_cast<long long>(interval.second) - interval.first + 1;
+            }
+            return total;
+        }
+
+        bool contains(T value) const{
+            check_merged();
+            //The last interval that starts at or before value
+            auto it = std::upper_bound(intervals_.begin(),intervals_.end(),value,[](T value, const Interval& interval){
+                return value < interval.first;
+            });
+            return it != intervals_.begin() && std::prev(it)->second >= value;
+        }
+
+        //The smallest integer in [lo,hi] that is not in the set (if any)
+        std::optional<T> first_gap(T lo, T hi) const{
+            check_merged();
+            T candidate = lo;
+            for(const auto& interval : intervals_){
+                if(candidate > hi){
+                    return std::nullopt;
+                }
+                if(interval.second < candidate){
+                    continue;
+                }
+                if(interval.first > candidate){
+                    break;
+                }
+                if(interval.second == std::numeric_limits<T>::max()){
+                    return std::nullopt;
+                }
+                candidate = interval.second + 1;
+            }
+            if(candidate > hi){
+                return std::nullopt;
+            }
+            return candidate;
+        }
+
+    private:
+        //There is at least one integer between end and a later start
+        static bool gap_between(T end, T start){
+            return end < start && end + 1 < start;
+        }
+
+        //Intervals a and b overlap or are adjacent
+        static bool touches(const Interval& a, const Interval& b){
+            return !gap_between(a.second,b.first) && !gap_between(b.second,a.first);
+        }
+
+        void check_merged() const{
+            if(!merged){
+                throw std::runtime_error("IntervalSet is not merged (call merge() after add())");
+            }
+        }
+
+        std::vector<Interval> intervals_;
+        bool merged = true;
+    };
+}
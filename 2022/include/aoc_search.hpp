@@ -0,0 +1,248 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <queue>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <cstdint>
+
+/*
+    Shortest path searches on implicit graphs.
+
+    The nodes of the graph are numbered 0 to n_nodes-1 (for a map, the flat
+    index of an aoc::Grid cell works well), and all per-node state is kept in
+    flat arrays indexed by that number. The edges are never stored: the search
+    calls neighbours(node, visit) whenever a node is expanded, and the callback
+    calls visit(neighbour, cost) for every edge (visit(neighbour) for bfs).
+    Costs are non-negative integers.
+
+        auto result = aoc::search::dijkstra(n_nodes, {start},
+            [&](int node, auto&& visit){
+                for(auto offset : map.neighbour_offsets()){
+                    if(can_move(node, node + offset)){
+                        visit(node + offset, 1);
+                    }
+                }
+            },
+            [&](int node){ return node == goal; });   //Optional early exit
+        int distance = result.distance[goal];
+
+    All searches accept several start nodes (multi-source search), and stop
+    as soon as a node is expanded for which is_goal(node) returns true.
+    Dijkstra and A* use a radix heap by default (the keys that are popped
+    never decrease, as long as an A* heuristic is consistent); pass
+    BinaryHeap as template argument for heuristics that are not.
+*/
+namespace aoc::search{
+
+    //Distance of nodes that were not reached
+    constexpr int unreachable = std::numeric_limits<int>::max();
+
+    struct Result{
+        std::vector<int> distance;      //Distance from the closest start node
+        std::vector<int> came_from;     //Previous node on the shortest path (-1 for start nodes)
+        int goal = -1;                  //Goal node the search stopped at, -1 if none
+
+        bool found() const{
+            return goal >= 0;
+        }
+
+        bool reached(int node) const{
+            return distance[node] != unreachable;
+        }
+
+        //Nodes on the shortest path to node, starting at a start node
+        std::vector<int> path(int node) const{
+            if(!reached(node)){
+                throw std::runtime_error("No path to node " + std::to_string(node));
+            }
+            std::vector<int> nodes;
+            for(; node >= 0; node = came_from[node]){
+                nodes.push_back(node);
+            }
+            std::reverse(nodes.begin(),nodes.end());
+            return nodes;
+        }
+    };
+
+    //The default goal: search the whole graph
+    struct NoGoal{
+        bool operator()(int) const{
+            return false;
+        }
+    };
+
+    //Min-heap of (key,node) pairs, based on std::priority_queue
+    class BinaryHeap{
+    public:
+        void push(int key, int node){
+            heap.emplace(key,node);
+        }
+        std::pair<int,int> pop(){
+            auto top = heap.top();
+            heap.pop();
+            return top;
+        }
+        bool empty() const{
+            return heap.empty();
+        }
+
+    private:
+        using entry = std::pair<int,int>;
+        std::priority_queue<entry,std::vector<entry>,std::greater<entry>> heap;
+    };
+
+    //Monotone min-heap of (key,node) pairs: a pushed key may not be smaller
+    //than the last key that was popped. Entries are kept in buckets by the
+    //highest bit in which their key differs from the last popped key, so a
+    //push is O(1), and every entry moves to a lower bucket at most 32 times.
+    class RadixHeap{
+    public:
+        void push(int key, int node){
+            if(static_cast<uint32_t>(key) < last){
+                throw std::runtime_error("RadixHeap: keys must not decrease");
+            }
+            buckets[bucket(key)].emplace_back(key,node);
+            n_entries++;
+        }
+        std::pair<int,int> pop(){
+            if(buckets[0].empty()){
+                //Redistribute the first non-empty bucket around its minimum
+                size_t i = 1;
+                while(buckets[i].empty()){
+                    i++;
+                }
+                last = std::min_element(buckets[i].begin(),buckets[i].end())->first;
+                for(const auto& entry : buckets[i]){
+                    buckets[bucket(entry.first)].push_back(entry);
+                }
+                buckets[i].clear();
+            }
+            auto top = buckets[0].back();
+            buckets[0].pop_back();
+            n_entries--;
+            return top;
+        }
+        bool empty() const{
+            return n_entries == 0;
+        }
+
+    private:
+        //Number of significant bits of key XOR last
+        size_t bucket(uint32_t key) const{
+            uint32_t diff = key ^ last;
+        #if defined(__GNUC__)
+            return diff == 0 ? 0 : 32 - __builtin_clz(diff);
+        #else
+            size_t bits = 0;
+            for(; diff != 0; diff >>= 1){
+                bits++;
+            }
+            return bits;
+        #endif
+        }
+
+        std::array<std::vector<std::pair<int,int>>,33> buckets;
+        uint32_t last = 0;
+        size_t n_entries = 0;
+    };
+
+    //Best-first search, shared by dijkstra and astar. The key of a node is
+    //its distance plus heuristic(node).
+    template<typename Heap, typename Neighbours, typename Heuristic, typename IsGoal>
+    Result best_first(int n_nodes, const std::vector<int>& sources, Neighbours&& neighbours,
+                      Heuristic&& heuristic, IsGoal&& is_goal){
+        Result result;
+        result.distance.assign(n_nodes,unreachable);
+        result.came_from.assign(n_nodes,-1);
+        std::vector<char> closed(n_nodes,false);
+
+        Heap open;
+        for(int source : sources){
+            result.distance[source] = 0;
+            open.push(heuristic(source),source);
+        }
+
+        int current;
+        auto visit = [&](int neighbour, int cost){
+            int distance = result.distance[current] + cost;
+            //This path to neighbour is better than any previous one. Record it!
+            if(distance < result.distance[neighbour]){
+                result.distance[neighbour]  = distance;
+                result.came_from[neighbour] = current;
+                open.push(distance + heuristic(neighbour),neighbour);
+            }
+        };
+
+        while(!open.empty()){
+            current = open.pop().second;
+            //Nodes are pushed again when a shorter path is found (instead of
+            //updating their key), so skip the outdated entries
+            if(closed[current]){
+                continue;
+            }
+            closed[current] = true;
+            if(is_goal(current)){
+                result.goal = current;
+                return result;
+            }
+            neighbours(current,visit);
+        }
+        return result;
+    }
+
+    //Shortest paths with non-negative edge costs
+    template<typename Heap = RadixHeap, typename Neighbours, typename IsGoal = NoGoal>
+    Result dijkstra(int n_nodes, const std::vector<int>& sources, Neighbours&& neighbours, IsGoal&& is_goal = {}){
+        return best_first<Heap>(n_nodes,sources,neighbours,[](int){ return 0; },is_goal);
+    }
+
+    //Shortest path guided by a heuristic that never overestimates the
+    //remaining distance
+    template<typename Heap = RadixHeap, typename Neighbours, typename Heuristic, typename IsGoal = NoGoal>
+    Result astar(int n_nodes, const std::vector<int>& sources, Neighbours&& neighbours, Heuristic&& heuristic,
+                 IsGoal&& is_goal = {}){
+        return best_first<Heap>(n_nodes,sources,neighbours,heuristic,is_goal);
+    }
+
+    //Shortest paths when every edge has cost 1. The callback calls
+    //visit(neighbour) for every edge.
+    template<typename Neighbours, typename IsGoal = NoGoal>
+    Result bfs(int n_nodes, const std::vector<int>& sources, Neighbours&& neighbours, IsGoal&& is_goal = {}){
+        Result result;
+        result.distance.assign(n_nodes,unreachable);
+        result.came_from.assign(n_nodes,-1);
+
+        //The queue is a flat array: every node is added at most once
+        std::vector<int> queue;
+        queue.reserve(n_nodes);
+        for(int source : sources){
+            if(result.distance[source] != 0){
+                result.distance[source] = 0;
+                queue.push_back(source);
+            }
+        }
+
+        int current;
+        auto visit = [&](int neighbour){
+            if(result.distance[neighbour] == unreachable){
+                result.distance[neighbour]  = result.distance[current] + 1;
+                result.came_from[neighbour] = current;
+                queue.push_back(neighbour);
+            }
+        };
+
+        for(size_t head = 0; head<queue.size(); head++){
+            current = queue[head];
+            if(is_goal(current)){
+                result.goal = current;
+                return result;
+            }
+            neighbours(current,visit);
+        }
+        return result;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,340 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+/*
+    A small work-stealing task scheduler.
+
+    Every worker thread has its own queue of tasks. A worker pushes and pops
+    tasks at the back of its own queue (so it works depth first, on the most
+    recent task), while idle workers steal from the front of the queues of
+    other workers (the oldest, and typically largest, tasks). Tasks spawned by
+    threads that are not part of the pool go to a shared queue.
+
+    Waiting for tasks (TaskGroup::sync) runs other pending tasks of the pool in
+    the meantime, and only sleeps when there are none. Tasks can therefore
+    spawn and sync tasks themselves (nested / recursive parallelism), which is
+    what the irregular search trees of some puzzles need. Since a waiting
+    thread may run any task of its pool, work that should never run nested in
+    another task (e.g. whole puzzles) belongs in a pool of its own.
+
+        aoc::TaskGroup group;
+        group.spawn([&](){ left  = search(a); });
+        group.spawn([&](){ right = search(b); });
+        group.sync();
+
+        aoc::parallel_for(0, n, grain, [&](int i){ ... });
+        int best = aoc::parallel_reduce(0, n, grain, 0, [&](int i){ return score(i); },
+                                        [](int a, int b){ return std::max(a,b); });
+
+    The global pool has one worker per hardware thread, unless the AOC_THREADS
+    environment variable is set (or TaskPool::set_global_threads is used).
+*/
+namespace aoc{
+
+    class TaskPool{
+    public:
+        using Task = std::function<void()>;
+
+        explicit TaskPool(unsigned n_threads = default_threads()) : queues(std::max(1u,n_threads)){
+            for(unsigned i = 0; i<queues.size(); i++){
+                workers.emplace_back([this,i](){ worker_loop(i); });
+            }
+        }
+
+        ~TaskPool(){
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for(auto& worker : workers){
+                worker.join();
+            }
+        }
+
+        TaskPool(const TaskPool&) = delete;
+        TaskPool& operator=(const TaskPool&) = delete;
+
+        //Number of threads used by the global pool: AOC_THREADS if set,
+        //otherwise the number of hardware threads
+        static unsigned default_threads(){
+            const char* threads = std::getenv("AOC_THREADS");
+            if(threads != nullptr){
+                return std::max(1,std::stoi(threads));
+            }
+            return std::max(1u,std::thread::hardware_concurrency());
+        }
+
+        //Set the number of threads of the global pool. Only has an effect
+        //before the global pool is used for the first time.
+        static void set_global_threads(unsigned n_threads){
+            global_threads() = n_threads;
+        }
+
+        //The pool shared by all puzzles (created on first use)
+        static TaskPool& global(){
+            static TaskPool pool(global_threads() > 0 ? global_threads() : default_threads());
+            return pool;
+        }
+
+        unsigned size() const{
+            return queues.size();
+        }
+
+        //Add a task to the pool. Workers add to their own queue, other threads
+        //to the shared queue.
+        void submit(Task task){
+            Queue& queue = (current_pool() == this) ? queues[current_index()] : shared;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(std::move(task));
+            }
+            n_queued++;
+            //Taking the lock guarantees that a worker that is about to sleep sees the new task
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+            }
+            wake.notify_one();
+            waiting.notify_all();
+        }
+
+        //Run a single pending task, if there is any. Returns false if there
+        //was nothing to do.
+        bool run_one(){
+            Task task;
+            if(!take(task)){
+                return false;
+            }
+            task();
+            return true;
+        }
+
+        //Run pending tasks until done() returns true. When there is nothing
+        //to run, the calling thread sleeps until a task is submitted, or
+        //until notify_waiters() is called.
+        template<typename Done>
+        void run_until(const Done& done){
+            while(!done()){
+                if(run_one()){
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                waiting.wait(lock,[&](){ return done() || n_queued.load() > 0; });
+            }
+        }
+
+        //Wake the threads in run_until, to check their done() again
+        void notify_waiters(){
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex);
+            }
+            waiting.notify_all();
+        }
+
+    private:
+        struct Queue{
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        static unsigned& global_threads(){
+            static unsigned n_threads = 0;
+            return n_threads;
+        }
+
+        //Pool and queue index of the calling thread (nullptr for non-workers)
+        static TaskPool*& current_pool(){
+            thread_local TaskPool* pool = nullptr;
+            return pool;
+        }
+        static unsigned& current_index(){
+            thread_local unsigned index = 0;
+            return index;
+        }
+
+        bool pop_back(Queue& queue, Task& task){
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(queue.tasks.empty()){
+                return false;
+            }
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            n_queued--;
+            return true;
+        }
+
+        bool pop_front(Queue& queue, Task& task){
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(queue.tasks.empty()){
+                return false;
+            }
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            n_queued--;
+            return true;
+        }
+
+        //Own queue first (newest task), then the shared queue, then steal
+        //(oldest task) from the other workers
+        bool take(Task& task){
+            if(n_queued.load(std::memory_order_relaxed) == 0){
+                return false;
+            }
+            bool worker = (current_pool() == this);
+            unsigned self = worker ? current_index() : 0;
+            if(worker && pop_back(queues[self],task)){
+                return true;
+            }
+            if(pop_front(shared,task)){
+                return true;
+            }
+            for(unsigned i = 0; i<queues.size(); i++){
+                unsigned victim = (self + i + worker) % queues.size();
+                if(pop_front(queues[victim],task)){
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void worker_loop(unsigned index){
+            current_pool()  = this;
+            current_index() = index;
+            while(true){
+                Task task;
+                if(take(task)){
+                    task();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                if(stopping){
+                    return;
+                }
+                wake.wait(lock,[this](){ return stopping || n_queued.load() > 0; });
+            }
+        }
+
+        std::vector<Queue> queues;          //One queue per worker
+        Queue shared;                       //Tasks submitted from outside the pool
+        std::vector<std::thread> workers;
+        std::atomic<long> n_queued{0};      //Number of tasks waiting in the queues
+        std::mutex sleep_mutex;
+        std::condition_variable wake;       //Idle workers
+        std::condition_variable waiting;    //Threads in run_until
+        bool stopping = false;
+    };
+
+    //A group of tasks that can be waited for. The first exception thrown by
+    //one of the tasks is rethrown by sync().
+    class TaskGroup{
+    public:
+        explicit TaskGroup(TaskPool& pool = TaskPool::global()) : pool(pool){}
+
+        //Tasks may refer to the group's scope, so always wait for them
+        ~TaskGroup(){
+            wait();
+        }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template<typename F>
+        void spawn(F&& f){
+            pending++;
+            pool.submit([this,&task_pool = pool,f = std::forward<F>(f)]() mutable {
+                try{
+                    f();
+                }catch(...){
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(!exception){
+                        exception = std::current_exception();
+                    }
+                }
+                //Last access to the group: it may be destroyed right after this
+                if(--pending == 0){
+                    task_pool.notify_waiters();
+                }
+            });
+        }
+
+        //Wait until all spawned tasks are done, running pending tasks meanwhile
+        void sync(){
+            wait();
+            if(exception){
+                std::exception_ptr e = exception;
+                exception = nullptr;
+                std::rethrow_exception(e);
+            }
+        }
+
+    private:
+        void wait(){
+            pool.run_until([this](){ return pending.load(std::memory_order_acquire) == 0; });
+        }
+
+        TaskPool& pool;
+        std::atomic<long> pending{0};
+        std::mutex mutex;
+        std::exception_ptr exception;
+    };
+
+    //Call f(i) for every i in [begin,end). The range is split in halves until
+    //the pieces are at most grain long; the pieces are run as tasks.
+    template<typename Index, typename F>
+    void parallel_for(Index begin, Index end, Index grain, const F& f, TaskPool& pool = TaskPool::global()){
+        grain = std::max<Index>(grain,1);
+        if(end - begin <= grain){
+            for(Index i = begin; i<end; i++){
+                f(i);
+            }
+            return;
+        }
+        //Spawn the right half, and continue splitting the left half
+        TaskGroup group(pool);
+        while(end - begin > grain){
+            Index middle = begin + (end - begin)/2;
+            group.spawn([middle,end,grain,&f,&pool](){
+                parallel_for(middle,end,grain,f,pool);
+            });
+            end = middle;
+        }
+        for(Index i = begin; i<end; i++){
+            f(i);
+        }
+        group.sync();
+    }
+
+    //Combine f(i) for every i in [begin,end) with reduce, starting from
+    //identity. The range is split like parallel_for.
+    template<typename T, typename Index, typename F, typename Reduce>
+    T parallel_reduce(Index begin, Index end, Index grain, T identity, const F& f, const Reduce& reduce,
+                      TaskPool& pool = TaskPool::global()){
+        grain = std::max<Index>(grain,1);
+        if(end - begin <= grain){
+            T result = identity;
+            for(Index i = begin; i<end; i++){
+                result = reduce(result,f(i));
+            }
+            return result;
+        }
+        Index middle = begin + (end - begin)/2;
+        T right = identity;
+        TaskGroup group(pool);
+        group.spawn([&](){
+            right = parallel_reduce(middle,end,grain,identity,f,reduce,pool);
+        });
+        T left = parallel_reduce(begin,middle,grain,identity,f,reduce,pool);
+        group.sync();
+        return reduce(left,right);
+    }
+}
\ No newline at end of file
@@ -1,25 +1,165 @@
+#pragma once
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <stdexcept>
+#include <charconv>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <type_traits>
+#include <chrono>
+#include <cstdlib>
+#include <array>
+#include <vector>
+#include <functional>
+#include <iomanip>
+#include <filesystem>
+#include <mutex>
+#include <condition_variable>
+#include <sstream>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#endif
+
+#ifdef AOC_TRACK_ALLOCATIONS
+#include "aoc_alloc.hpp"
+#endif
+#include "aoc_cache.hpp"
+#include "aoc_tasks.hpp"
 
 /*
     Small collection of some utility functions that should make coding for
     aoc just a bit more easy.
 */
 namespace aoc{
-    //Parse the program arguments, and extract the desired part number
-    //Throws an error if no part number is provided, or if the part number is not 1 or 2
-    int get_part_number(int argc, char* argv[]){
-        if(argc == 2){
-            int part = std::stoi(argv[1]);
-            if(part != 1 && part != 2){
-                std::string error_message;
-                error_message = "Illegal part number (" + std::to_string(part) + ") used, should be 1 or 2!";
-                throw std::runtime_error(error_message);
+    //Part number passed to puzzles to solve both parts in a single run
+    constexpr int all_parts = 0;
+
+    //Convert a part argument (1, 2 or "all") to a part number.
+    //Throws an error if the part number is not 1, 2 or all
+    inline int to_part_number(const std::string& arg){
+        if(arg == "all"){
+            return all_parts;
+        }else if(arg == "1" || arg == "2"){
+            return std::stoi(arg);
+        }else{
+            throw std::runtime_error("Illegal part number (" + arg + ") used, should be 1, 2 or all!");
+        }
+    }
+
+    //Command line options of the puzzle executables:
+    //  ./puzzleN [1|2|all] [--input <path>] [--repeat N] [--quiet] [--cache]
+    //  ./puzzleN [1|2|all] --batch <dir|listfile> [--quiet] [--cache]
+    struct Options{
+        std::string program;                //Name of the executable, e.g. puzzle6
+        int part = all_parts;               //Part number (aoc::all_parts for both)
+        std::string input = "input.txt";    //Input file, "-" for stdin
+        int repeat = 1;                     //Number of times the puzzle is solved
+        bool quiet = false;                 //Discard the output of the puzzle
+        bool cache = false;                 //Use the on-disk result cache (aoc_cache.hpp)
+        std::string batch;                  //Directory or list of inputs to solve (instead of input)
+        bool stream = false;                //Solve in a single pass, with bounded memory (InputStream)
+    };
+
+    //Parse the program arguments into Options. Throws an error for unknown
+    //arguments, or for arguments with an invalid (or missing) value
+    inline Options get_options(int argc, char* argv[]){
+        const std::string usage = "Call this script as:  ./puzzleN [1|2|all] [--input <path>|-] [--repeat N] [--batch <dir|listfile>] [--quiet] [--cache] [--stream]";
+        Options options;
+        if(argc > 0){
+            options.program = argv[0];
+            options.program.erase(0,options.program.find_last_of("/\\") + 1);
+        }
+        bool part_given = false;
+        for(int i = 1; i<argc; i++){
+            std::string arg = argv[i];
+            //Options that take a value
+            auto value = [&](){
+                if(i+1 >= argc){
+                    throw std::runtime_error("Missing value for " + arg + ". " + usage);
+                }
+                return std::string(argv[++i]);
+            };
+            if(arg == "--input"){
+                options.input = value();
+            }else if(arg == "-"){
+                options.input = "-";
+            }else if(arg == "--repeat"){
+                //The whole argument must be a number
+                std::string n = value();
+                auto [end,error] = std::from_chars(n.data(),n.data()+n.size(),options.repeat);
+                if(error != std::errc() || end != n.data()+n.size() || options.repeat < 1){
+                    throw std::runtime_error("Illegal repeat count (" + n + "), should be a whole number of at least 1");
+                }
+            }else if(arg == "--quiet"){
+                options.quiet = true;
+            }else if(arg == "--cache"){
+                options.cache = true;
+            }else if(arg == "--batch"){
+                options.batch = value();
+            }else if(arg == "--stream"){
+                options.stream = true;
+            }else if(!part_given && arg.rfind("--",0) != 0){
+                options.part = to_part_number(arg);
+                part_given = true;
             }else{
-                return part;
+                throw std::runtime_error("Unknown argument (" + arg + "). " + usage);
             }
-        }else{
-            throw std::runtime_error("This puzzle requires a part number (1 or 2) as input. Call this script as:  ./puzzle6 <part_number> ");
+        }
+        if(!options.batch.empty() && (options.input != "input.txt" || options.repeat != 1)){
+            throw std::runtime_error("--batch can not be combined with --input or --repeat");
+        }
+        if(options.stream && (options.cache || !options.batch.empty())){
+            throw std::runtime_error("--stream can not be combined with --cache or --batch");
+        }
+        return options;
+    }
+
+    //Parse the program arguments, and extract the desired part number:
+    //1, 2 or "all" (aoc::all_parts, also the default if no part is given)
+    //Throws an error if the part number is not 1, 2 or all
+    inline int get_part_number(int argc, char* argv[]){
+        return get_options(argc,argv).part;
+    }
+
+    //The parts to solve for a part number: both for all_parts, otherwise
+    //just the given part
+    inline std::vector<int> parts(int part){
+        if(part == all_parts){
+            return {1,2};
+        }
+        return {part};
+    }
+
+    //Compile-time part number, see for_each_part
+    template<int N>
+    using Part = std::integral_constant<int,N>;
+
+    //Call f for every part to solve, with the part number as a compile-time
+    //constant (aoc::Part<1> or aoc::Part<2>). The part is dispatched once, so
+    //part-specific code can be a template instantiated for each part:
+    //    aoc::for_each_part(part,[&](auto p){ simulate<decltype(p)::value>(data,out); });
+    template<typename F>
+    void for_each_part(int part, F&& f){
+        if(part == all_parts || part == 1){
+            f(Part<1>{});
+        }
+        if(part == all_parts || part == 2){
+            f(Part<2>{});
         }
     }
 
@@ -31,4 +171,1172 @@ namespace aoc{
     T mod(T a, T b){
         return (b + (a % b)) % b;
     }
-}
\ No newline at end of file
+
+    //Hardware performance counters of the calling thread, read directly through
+    //the perf_event_open system call (Linux only, no external tools needed).
+    //Events that are not supported by the CPU / virtual machine, or that are not
+    //permitted (see /proc/sys/kernel/perf_event_paranoid) are reported as -1.
+    //Only user space is counted, so this also works for unprivileged users.
+    class PerfCounters{
+    public:
+        static constexpr int n_events = 6;
+        using Values = std::array<long long,n_events>;
+
+        explicit PerfCounters(bool enable = true){
+            fds.fill(-1);
+            previous.fill(0);
+#ifdef __linux__
+            if(!enable){
+                return;
+            }
+            for(int i = 0; i<n_events; i++){
+                perf_event_attr attr;
+                std::memset(&attr,0,sizeof(attr));
+                attr.size           = sizeof(attr);
+                attr.type           = events()[i].type;
+                attr.config         = events()[i].config;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv     = 1;
+                //Needed to correct for multiplexing, when there are more events than hardware counters
+                attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                fds[i] = syscall(SYS_perf_event_open,&attr,0,-1,-1,0);
+            }
+#else
+            (void)enable;
+#endif
+        }
+
+        ~PerfCounters(){
+#ifdef __linux__
+            for(int fd : fds){
+                if(fd >= 0){
+                    close(fd);
+                }
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        //Name of an event, as reported to the benchmark harness
+        static const char* name(int i){
+            return events()[i].name;
+        }
+
+        //True if at least one event could be opened
+        bool available() const{
+            return std::any_of(fds.begin(),fds.end(),[](int fd){ return fd >= 0; });
+        }
+
+        //Counter values since the previous call to read (or since construction)
+        Values read(){
+            Values values;
+            values.fill(-1);
+#ifdef __linux__
+            for(int i = 0; i<n_events; i++){
+                //value, time enabled, time running
+                uint64_t data[3];
+                if(fds[i] < 0 || ::read(fds[i],data,sizeof(data)) != sizeof(data)){
+                    continue;
+                }
+                long long total = (data[2] > 0) ? (long long)((double)data[0]*data[1]/data[2]) : 0;
+                values[i]   = total - previous[i];
+                previous[i] = total;
+            }
+#endif
+            return values;
+        }
+
+    private:
+        struct Event{
+            const char* name;
+            uint32_t    type;
+            uint64_t    config;
+        };
+
+        static const std::array<Event,n_events>& events(){
+#ifdef __linux__
+            static const std::array<Event,n_events> list = {{
+                {"cycles",       PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {"l1d_misses",   PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+                {"llc_misses",   PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL  | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+                {"branch_misses",PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                {"page_faults",  PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+            }};
+#else
+            static const std::array<Event,n_events> list = {{
+                {"cycles",0,0}, {"instructions",0,0}, {"l1d_misses",0,0},
+                {"llc_misses",0,0}, {"branch_misses",0,0}, {"page_faults",0,0},
+            }};
+#endif
+            return list;
+        }
+
+        std::array<int,n_events> fds;
+        Values previous;
+    };
+
+    //Measures the time spent in the phases of a puzzle (typically "parse" and
+    //"solve"), for the benchmark harness (aoc_bench). The timings are only
+    //reported if the AOC_BENCH environment variable is set, in which case
+    //every phase is written to stderr as:  aoc_bench <phase> <nanoseconds>
+    //If AOC_PERF is set as well, the hardware counters of every phase are
+    //reported too, as:  aoc_bench <phase>.<event> <count>
+    //Puzzles that link the aoc_alloc library also report their heap allocations
+    //per phase (allocations, bytes and peak_heap).
+    //A listener can be installed to receive the phase timings of the current
+    //thread as well (aoc_served uses this to report the timings per request).
+    class PhaseTimer{
+    public:
+        using Listener = std::function<void(const char* phase, long long ns)>;
+
+        //Listener of the current thread (nullptr if there is none). Save and
+        //restore the previous one when installing a listener: a thread that
+        //waits for tasks may run a nested solve in the meantime.
+        static Listener*& listener(){
+            thread_local Listener* current = nullptr;
+            return current;
+        }
+
+        PhaseTimer() : enabled(std::getenv("AOC_BENCH") != nullptr),
+                       perf(enabled && std::getenv("AOC_PERF") != nullptr),
+                       start(std::chrono::steady_clock::now()){
+#ifdef AOC_TRACK_ALLOCATIONS
+            //Allocations before the first phase (static initialization)
+            aoc::alloc::end_phase("startup");
+#endif
+        }
+
+        //End the current phase, and start the next one
+        void phase(const char* name){
+            auto now = std::chrono::steady_clock::now();
+#ifdef AOC_TRACK_ALLOCATIONS
+            aoc::alloc::Statistics allocations = aoc::alloc::end_phase(name);
+#endif
+            if(listener() != nullptr){
+                (*listener())(name,std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count());
+            }
+            if(enabled){
+                PerfCounters::Values counters = perf.read();
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+                std::cerr << "aoc_bench " << name << " " << ns << std::endl;
+                for(int i = 0; i<PerfCounters::n_events; i++){
+                    if(counters[i] >= 0){
+                        std::cerr << "aoc_bench " << name << "." << PerfCounters::name(i) << " " << counters[i] << std::endl;
+                    }
+                }
+#ifdef AOC_TRACK_ALLOCATIONS
+                std::cerr << "aoc_bench " << name << ".allocations " << allocations.allocations << std::endl;
+                std::cerr << "aoc_bench " << name << ".alloc_bytes " << allocations.bytes << std::endl;
+                std::cerr << "aoc_bench " << name << ".peak_heap " << allocations.peak << std::endl;
+#endif
+                //Do not count the reporting itself
+                perf.read();
+                now = std::chrono::steady_clock::now();
+            }
+            start = now;
+        }
+
+    private:
+        bool enabled;
+        PerfCounters perf;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    //Read-only view of an input file. The file is memory mapped once, and
+    //lines / blocks are handed out as std::string_view's pointing directly
+    //into the mapping, so no copies or allocations are made while reading.
+    //Rewinding is free: it only resets the read position.
+    //The views stay valid for as long as the InputView is alive.
+    //The filename "-" reads the input from stdin: a redirected file is mapped
+    //as well, a pipe is read into a buffer.
+    class InputView{
+    public:
+        //Tag for the constructor that takes the input itself, instead of a filename
+        struct FromMemory{};
+
+        //View on input that is already in memory (e.g. received over a socket)
+        InputView(FromMemory, std::string data) : buffer(std::move(data)){
+            contents = buffer;
+        }
+
+        explicit InputView(const std::string& filename){
+        #ifdef _WIN32
+            //No mmap available, fall back to reading the file into a buffer
+            std::stringstream buffer_stream;
+            if(filename == "-"){
+                buffer_stream << std::cin.rdbuf();
+            }else{
+                std::ifstream infs(filename, std::ios::binary);
+                if(!infs){
+                    throw std::runtime_error("Could not open input file " + filename);
+                }
+                buffer_stream << infs.rdbuf();
+            }
+            buffer   = buffer_stream.str();
+            contents = buffer;
+        #else
+            if(filename == "-"){
+                load(STDIN_FILENO, "<stdin>");
+                return;
+            }
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if(fd < 0){
+                throw std::runtime_error("Could not open input file " + filename);
+            }
+            try{
+                load(fd, filename);
+            }catch(...){
+                ::close(fd);
+                throw;
+            }
+            //The mapping stays valid after closing the file descriptor
+            ::close(fd);
+        #endif
+        }
+
+        ~InputView(){
+        #ifndef _WIN32
+            if(mapping != nullptr){
+                ::munmap(mapping, mapping_size);
+            }
+        #endif
+        }
+
+        //The mapping is owned, so copying is not allowed
+        InputView(const InputView&) = delete;
+        InputView& operator=(const InputView&) = delete;
+
+        //Entire contents of the input
+        std::string_view data() const{
+            return contents;
+        }
+
+        //Read the next line (without the newline character) into line.
+        //Returns false if the end of the input was reached, similar to std::getline
+        bool getline(std::string_view& line){
+            if(position >= contents.size()){
+                return false;
+            }
+            size_t end = contents.find('\n', position);
+            if(end == std::string_view::npos){
+                //Final line is not terminated with a newline
+                end = contents.size();
+            }
+            line     = contents.substr(position, end - position);
+            position = end + 1;
+            return true;
+        }
+
+        //Read the next block of lines into block. Blocks are separated by an
+        //empty line; the block itself does not contain the trailing newline.
+        //Returns false if the end of the input was reached
+        bool get_block(std::string_view& block){
+            if(position >= contents.size()){
+                return false;
+            }
+            size_t end = contents.find("\n\n", position);
+            if(end == std::string_view::npos){
+                end = contents.size();
+                //Strip the newline at the end of the file (if any)
+                if(end > position && contents[end-1] == '\n'){
+                    end--;
+                }
+            }
+            block    = contents.substr(position, end - position);
+            position = std::min(end + 2, contents.size());
+            return true;
+        }
+
+        //Go back to the start of the input. No I/O is involved.
+        void rewind(){
+            position = 0;
+        }
+
+        //True if all input has been read
+        bool eof() const{
+            return position >= contents.size();
+        }
+
+    private:
+    #ifndef _WIN32
+        //Map the file behind fd, or read it into the buffer if it can not be
+        //mapped (pipes, terminals)
+        void load(int fd, const std::string& name){
+            struct stat file_stat;
+            if(::fstat(fd, &file_stat) != 0){
+                throw std::runtime_error("Could not stat input file " + name);
+            }
+            if(!S_ISREG(file_stat.st_mode)){
+                char chunk[1 << 16];
+                ssize_t n;
+                while((n = ::read(fd, chunk, sizeof(chunk))) != 0){
+                    if(n < 0){
+                        throw std::runtime_error("Could not read input file " + name);
+                    }
+                    buffer.append(chunk, n);
+                }
+                contents = buffer;
+                return;
+            }
+            mapping_size = file_stat.st_size;
+            //Mapping an empty file is not allowed, an empty view is fine
+            if(mapping_size > 0){
+                mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(mapping == MAP_FAILED){
+                    mapping = nullptr;
+                    throw std::runtime_error("Could not memory map input file " + name);
+                }
+                //The input is read front to back (and possibly rewound)
+                ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+                contents = std::string_view(static_cast<const char*>(mapping), mapping_size);
+            }
+        }
+    #endif
+
+        std::string_view contents;  //View on the (mapped) file contents
+        size_t position = 0;        //Current read position
+        void*  mapping  = nullptr;  //Start of the memory mapping
+        size_t mapping_size = 0;    //Size of the memory mapping
+        std::string buffer;         //Owned file contents, if the file can not be mapped
+    };
+
+    //Single pass reader for inputs of any size (e.g. logs that do not fit in
+    //memory), used by the streaming solvers (--stream). In contrast to
+    //InputView, memory use does not grow with the input:
+    // - a regular file (or stdin redirected from one) is memory mapped, and
+    //   the pages that were read are released again while reading;
+    // - a pipe is read in chunks into a buffer of chunk_size bytes (which
+    //   only grows for lines that are longer than that).
+    //Lines and chunks are only valid until the next call.
+    class InputStream{
+    public:
+        explicit InputStream(const std::string& filename, size_t chunk_size = 1 << 20)
+            : buffer(std::max<size_t>(chunk_size,64)){
+        #ifdef _WIN32
+            if(filename == "-"){
+                stream = &std::cin;
+            }else{
+                file.open(filename, std::ios::binary);
+                if(!file){
+                    throw std::runtime_error("Could not open input file " + filename);
+                }
+                stream = &file;
+            }
+        #else
+            if(filename == "-"){
+                fd = STDIN_FILENO;
+            }else{
+                fd = ::open(filename.c_str(), O_RDONLY);
+                if(fd < 0){
+                    throw std::runtime_error("Could not open input file " + filename);
+                }
+                owns_fd = true;
+            }
+            name = (filename == "-") ? "<stdin>" : filename;
+            struct stat file_stat;
+            if(::fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0){
+                mapping_size = file_stat.st_size;
+                mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(mapping == MAP_FAILED){
+                    //Fall back to reading the file in chunks
+                    mapping = nullptr;
+                }else{
+                    ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+                    contents = std::string_view(static_cast<const char*>(mapping), mapping_size);
+                }
+            }
+        #endif
+        }
+
+        ~InputStream(){
+        #ifndef _WIN32
+            if(mapping != nullptr){
+                ::munmap(mapping, mapping_size);
+            }
+            if(owns_fd){
+                ::close(fd);
+            }
+        #endif
+        }
+
+        InputStream(const InputStream&) = delete;
+        InputStream& operator=(const InputStream&) = delete;
+
+        //Read the next line (without the newline character) into line.
+        //Returns false if the end of the input was reached
+        bool getline(std::string_view& line){
+            if(mapping != nullptr){
+                release_read_pages();
+                if(position >= contents.size()){
+                    return false;
+                }
+                size_t end = contents.find('\n', position);
+                if(end == std::string_view::npos){
+                    end = contents.size();
+                }
+                line     = contents.substr(position, end - position);
+                position = end + 1;
+                return true;
+            }
+            size_t searched = begin;
+            while(true){
+                const void* newline = std::memchr(buffer.data() + searched, '\n', end - searched);
+                if(newline != nullptr){
+                    size_t line_end = static_cast<const char*>(newline) - buffer.data();
+                    line  = std::string_view(buffer.data() + begin, line_end - begin);
+                    begin = line_end + 1;
+                    return true;
+                }
+                if(at_end){
+                    if(begin == end){
+                        return false;
+                    }
+                    //Final line is not terminated with a newline
+                    line  = std::string_view(buffer.data() + begin, end - begin);
+                    begin = end;
+                    return true;
+                }
+                //The part that was searched moves to the front of the buffer
+                searched = end - begin;
+                fill();
+            }
+        }
+
+        //Read the next chunk of raw input (of any size, up to chunk_size).
+        //Returns false if the end of the input was reached
+        bool read(std::string_view& chunk){
+            if(mapping != nullptr){
+                release_read_pages();
+                if(position >= contents.size()){
+                    return false;
+                }
+                chunk     = contents.substr(position, buffer.size());
+                position += chunk.size();
+                return true;
+            }
+            if(begin == end){
+                if(at_end){
+                    return false;
+                }
+                fill();
+                if(begin == end){
+                    return false;
+                }
+            }
+            chunk = std::string_view(buffer.data() + begin, end - begin);
+            begin = end;
+            return true;
+        }
+
+    private:
+        //Move the unread data to the front of the buffer, and read more input
+        //behind it (the buffer grows if it is full)
+        void fill(){
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end  -= begin;
+            begin = 0;
+            if(end == buffer.size()){
+                buffer.resize(2*buffer.size());
+            }
+            size_t n = read_some(buffer.data() + end, buffer.size() - end);
+            if(n == 0){
+                at_end = true;
+            }
+            end += n;
+        }
+
+        //Give the pages before the current position back to the OS (every
+        //16 MB). The mapping is only read, so released pages are simply dropped.
+        void release_read_pages(){
+        #ifndef _WIN32
+            constexpr size_t release_size = 16 << 20;
+            if(position < released + release_size || position > contents.size()){
+                return;
+            }
+            size_t page  = ::sysconf(_SC_PAGESIZE);
+            size_t until = position / page * page;
+            ::madvise(static_cast<char*>(mapping) + released, until - released, MADV_DONTNEED);
+            released = until;
+        #endif
+        }
+
+    #ifdef _WIN32
+        size_t read_some(char* data, size_t size){
+            stream->read(data, size);
+            return stream->gcount();
+        }
+
+        std::ifstream file;
+        std::istream* stream = nullptr;
+    #else
+        size_t read_some(char* data, size_t size){
+            while(true){
+                ssize_t n = ::read(fd, data, size);
+                if(n >= 0){
+                    return n;
+                }
+                if(errno != EINTR){
+                    throw std::runtime_error("Could not read input file " + name);
+                }
+            }
+        }
+
+        int fd = -1;
+        bool owns_fd = false;
+        std::string name;
+    #endif
+        //Memory mapped file
+        void*  mapping      = nullptr;
+        size_t mapping_size = 0;
+        std::string_view contents;  //The whole mapping
+        size_t position = 0;        //Current read position in the mapping
+        size_t released = 0;        //Start of the pages that were not released yet
+
+        //Chunked reading
+        std::vector<char> buffer;
+        size_t begin  = 0;          //Start of the unread data in the buffer
+        size_t end    = 0;          //End of the data in the buffer
+        bool   at_end = false;      //No more input to read
+    };
+
+    //Every puzzle provides a solve function (puzzleN::solve), which solves
+    //the given part of the puzzle for the input, and writes the results to out
+    using SolveFunction = void(*)(InputView& input, int part, std::ostream& out);
+
+    //Solve the puzzle once for the input. With --cache, a stored result for
+    //the same input and build is written instead, and new results are stored.
+    inline void solve_input(const Options& options, SolveFunction solve, InputView& input, std::ostream& out){
+        if(!options.cache){
+            solve(input, options.part, out);
+            return;
+        }
+        ResultCache cache(ResultCache::default_directory(), ResultCache::default_size());
+        std::string key = ResultCache::key(options.program, options.part, input.data());
+        std::string output;
+        if(!cache.lookup(key, output)){
+            std::ostringstream solved;
+            solve(input, options.part, solved);
+            output = solved.str();
+            cache.store(key, output);
+        }
+        out << output;
+    }
+
+    //The input files of a batch: the files in a directory (in name order), or
+    //the paths listed in a file (one per line)
+    inline std::vector<std::string> batch_files(const std::string& batch){
+        std::vector<std::string> files;
+        std::error_code error;
+        if(std::filesystem::is_directory(batch, error)){
+            for(const auto& entry : std::filesystem::directory_iterator(batch)){
+                if(entry.is_regular_file()){
+                    files.push_back(entry.path().string());
+                }
+            }
+            std::sort(files.begin(), files.end());
+        }else{
+            InputView list(batch);
+            std::string_view line;
+            while(list.getline(line)){
+                if(!line.empty()){
+                    files.emplace_back(line);
+                }
+            }
+        }
+        return files;
+    }
+
+    //Solve every input of a batch (--batch), as a task per input on a pool of
+    //its own. The puzzles run their parallel loops on the global pool, so a
+    //thread that waits within a puzzle never picks up another input. The
+    //largest inputs are started first, and the results are printed as soon
+    //as they are done, so a slow input never holds up the others. Finally,
+    //the throughput is printed. Returns 1 if any of the inputs failed.
+    inline int run_batch(const Options& options, SolveFunction solve){
+        struct Job{
+            Job(const std::string& file, uintmax_t bytes) : file(file), bytes(bytes){}
+
+            std::string file;
+            uintmax_t bytes = 0;
+            std::string output;     //Everything the puzzle wrote
+            std::string error;      //Exception message, if the puzzle failed
+            double ms = 0;
+        };
+        std::vector<Job> jobs;
+        uintmax_t total_bytes = 0;
+        for(const auto& file : batch_files(options.batch)){
+            std::error_code error;
+            uintmax_t bytes = std::filesystem::file_size(file, error);
+            jobs.emplace_back(file, error ? 0 : bytes);
+            total_bytes += jobs.back().bytes;
+        }
+        std::vector<Job*> order;
+        for(auto& job : jobs){
+            order.push_back(&job);
+        }
+        std::stable_sort(order.begin(), order.end(), [](const Job* a, const Job* b){ return a->bytes > b->bytes; });
+
+        std::mutex mutex;
+        std::condition_variable job_done;
+        std::vector<Job*> done;     //Finished jobs, in the order in which they finished
+
+        TaskPool pool(TaskPool::default_threads());
+        auto start = std::chrono::steady_clock::now();
+        TaskGroup group(pool);
+        for(Job* job : order){
+            group.spawn([job,&options,solve,&mutex,&job_done,&done](){
+                std::ostringstream out;
+                auto job_start = std::chrono::steady_clock::now();
+                try{
+                    InputView input(job->file);
+                    solve_input(options, solve, input, out);
+                }catch(const std::exception& e){
+                    job->error = e.what();
+                }
+                auto job_end = std::chrono::steady_clock::now();
+                job->ms     = std::chrono::duration<double,std::milli>(job_end - job_start).count();
+                job->output = out.str();
+                std::lock_guard<std::mutex> lock(mutex);
+                done.push_back(job);
+                job_done.notify_one();
+            });
+        }
+
+        //Print the results in the order in which they finish
+        std::cout << std::fixed << std::setprecision(3);
+        int n_failed = 0;
+        for(size_t n_printed = 0; n_printed<jobs.size(); n_printed++){
+            Job* job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                job_done.wait(lock, [&](){ return done.size() > n_printed; });
+                job = done[n_printed];
+            }
+            std::cout << "==== " << job->file << " (" << job->ms << " ms)" << std::endl;
+            if(!options.quiet){
+                std::cout << job->output;
+            }
+            if(!job->error.empty()){
+                std::cout << "FAILED: " << job->error << std::endl;
+                n_failed++;
+            }
+        }
+        group.sync();
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << "==== " << jobs.size() << " inputs (" << total_bytes/1e6 << " MB) on " << pool.size()
+                  << " threads: wall time " << seconds*1e3 << " ms, " << jobs.size()/seconds << " inputs/s, "
+                  << total_bytes/1e6/seconds << " MB/s" << std::endl;
+        return n_failed == 0 ? 0 : 1;
+    }
+
+    //Print the min, median and max time of repeated runs (--repeat)
+    inline void report_runs(std::vector<double> ms){
+        if(ms.size() > 1){
+            std::sort(ms.begin(), ms.end());
+            std::cerr << ms.size() << " runs: min " << ms.front() << " ms, median "
+                      << ms[ms.size()/2] << " ms, max " << ms.back() << " ms" << std::endl;
+        }
+    }
+
+    //Main function of the puzzle executables: solve the puzzle for the input
+    //and part selected on the command line (see Options). The input is loaded
+    //once; with --repeat, it is rewound and solved again, but only the output
+    //of the first run is printed. The wall time of the runs is summarized on
+    //stderr (the phases are reported to aoc_bench for every run).
+    inline int run(const Options& options, SolveFunction solve){
+        if(!options.batch.empty()){
+            return run_batch(options, solve);
+        }
+        if(options.stream){
+            throw std::runtime_error(options.program + " has no streaming solver (--stream)");
+        }
+
+        InputView input(options.input);
+
+        //A stream without buffer discards everything written to it
+        std::ostream discard(nullptr);
+        std::vector<double> ms;
+        for(int i = 0; i<options.repeat; i++){
+            input.rewind();
+            auto start = std::chrono::steady_clock::now();
+            solve_input(options, solve, input, (options.quiet || i > 0) ? discard : std::cout);
+            auto end = std::chrono::steady_clock::now();
+            ms.push_back(std::chrono::duration<double,std::milli>(end - start).count());
+        }
+        report_runs(ms);
+        return 0;
+    }
+
+    //Puzzles that can be solved in a single pass over the input, with bounded
+    //memory, also provide a streaming solve function (puzzleN::solve_stream),
+    //which always solves both parts
+    using StreamSolveFunction = void(*)(InputStream& input, std::ostream& out);
+
+    //Run the puzzle like run(options,solve), but with --stream the input is
+    //streamed through solve_stream instead of being loaded as a whole
+    inline int run(const Options& options, SolveFunction solve, StreamSolveFunction solve_stream){
+        if(!options.stream){
+            return run(options, solve);
+        }
+        if(options.input == "-" && options.repeat > 1){
+            throw std::runtime_error("--repeat can not be combined with --stream from stdin (it can only be read once)");
+        }
+
+        std::ostream discard(nullptr);
+        std::vector<double> ms;
+        for(int i = 0; i<options.repeat; i++){
+            auto start = std::chrono::steady_clock::now();
+            InputStream input(options.input);
+            solve_stream(input, (options.quiet || i > 0) ? discard : std::cout);
+            auto end = std::chrono::steady_clock::now();
+            ms.push_back(std::chrono::duration<double,std::milli>(end - start).count());
+        }
+        report_runs(ms);
+        return 0;
+    }
+
+    //Split off the first field of text, delimited by delim. The field is
+    //returned, and text is advanced to just after the delimiter. If the
+    //delimiter is not found, the whole text is returned and text becomes empty.
+    inline std::string_view next_field(std::string_view& text, std::string_view delim){
+        size_t delim_pos = text.find(delim);
+        std::string_view field = text.substr(0, delim_pos);
+        if(delim_pos == std::string_view::npos){
+            text = std::string_view();
+        }else{
+            text.remove_prefix(delim_pos + delim.size());
+        }
+        return field;
+    }
+
+    inline std::string_view next_field(std::string_view& text, char delim){
+        return next_field(text, std::string_view(&delim, 1));
+    }
+
+    //Parse up to 8 ASCII digits at once, SWAR style ("SIMD within a register").
+    //chunk holds 8 bytes of text, read in little-endian order. Returns the number
+    //of leading digits in chunk (0-8), and their value in value.
+    //See e.g. https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/
+    inline int parse_digits_swar(uint64_t chunk, uint64_t& value){
+        //'0'-'9' are 0x30-0x39. After the xor, digits are 0x00-0x09. A byte is
+        //a digit if its high nibble is 0, and it stays 0 after adding 6.
+        uint64_t digits     = chunk ^ 0x3030303030303030ULL;
+        uint64_t non_digits = (digits | (digits + 0x0606060606060606ULL)) & 0xF0F0F0F0F0F0F0F0ULL;
+        int n_digits = (non_digits == 0) ? 8 : __builtin_ctzll(non_digits) / 8;
+        if(n_digits == 0){
+            value = 0;
+            return 0;
+        }
+        //Shift the digits to the top of the register, the zero bytes that are
+        //shifted in act as leading zeros
+        digits <<= 8*(8 - n_digits);
+        //Combine pairs of digits, then pairs of pairs, then pairs of quads
+        digits = (digits * 10) + (digits >> 8);
+        digits = (((digits & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+                  (((digits >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >> 32;
+        value = digits;
+        return n_digits;
+    }
+
+    //Allocation free scanner over a range of text. Reads integers, skips
+    //separators and checks literals, without creating temporary strings.
+    //The scanner does not own the text; the text must outlive the scanner.
+    class Scanner{
+    public:
+        explicit Scanner(std::string_view text) : 
+            begin(text.data()), current(text.data()), end(text.data() + text.size()){}
+        Scanner(const char* begin, const char* end) : begin(begin), current(begin), end(end){}
+
+        //True if all text has been consumed
+        bool done() const{
+            return current >= end;
+        }
+
+        //The next character, without consuming it ('\0' at the end of the text)
+        char peek() const{
+            return done() ? '\0' : *current;
+        }
+
+        //Consume and return the next character
+        char next_char(){
+            if(done()){
+                throw std::runtime_error("Scanner: unexpected end of input");
+            }
+            return *current++;
+        }
+
+        //Skip n characters (or until the end of the text)
+        void skip(size_t n){
+            current = std::min(current + n, end);
+        }
+
+        //Skip to the next occurrence of c (c is not consumed).
+        //Returns false (and skips to the end) if c does not occur
+        bool skip_until(char c){
+            const void* found = std::memchr(current, c, end - current);
+            if(found == nullptr){
+                current = end;
+                return false;
+            }
+            current = static_cast<const char*>(found);
+            return true;
+        }
+
+        //Skip past the next occurrence of c (c is consumed).
+        //Returns false (and skips to the end) if c does not occur
+        bool skip_past(char c){
+            bool found = skip_until(c);
+            skip(found ? 1 : 0);
+            return found;
+        }
+
+        //True if the remaining text starts with literal
+        bool starts_with(std::string_view literal) const{
+            return size_t(end - current) >= literal.size() && 
+                   std::memcmp(current, literal.data(), literal.size()) == 0;
+        }
+
+        //Consume literal. Throws if the text does not continue with literal
+        void expect(std::string_view literal){
+            if(!starts_with(literal)){
+                throw std::runtime_error("Scanner: expected <" + std::string(literal) + 
+                                         "> but found <" + std::string(rest().substr(0,literal.size())) + ">");
+            }
+            current += literal.size();
+        }
+
+        //Consume and return all text up to (not including) delim. The delimiter
+        //itself is consumed as well. Returns the rest of the text if delim does not occur
+        std::string_view next_field(char delim){
+            const char* start = current;
+            bool found = skip_until(delim);
+            std::string_view field(start, current - start);
+            skip(found ? 1 : 0);
+            return field;
+        }
+
+        //Find and parse the next integer. Any characters before the number are
+        //skipped. For signed types, a '-' directly in front of the digits makes
+        //the number negative, unless the '-' itself directly follows a digit
+        //(so "2-4" reads as 2 and 4, while "x=-4" reads as -4).
+        //No overflow checks are performed. Throws if no integer is found.
+        template<typename T = int>
+        T next_int(){
+            static_assert(std::is_integral_v<T>, "next_int requires an integer type");
+            using U = std::make_unsigned_t<T>;
+            
+            //Find the first digit
+            while(current < end && !is_digit(*current)){
+                current++;
+            }
+            if(current == end){
+                throw std::runtime_error("Scanner: no integer found");
+            }
+            
+            bool negative = false;
+            if constexpr(std::is_signed_v<T>){
+                negative = is_sign(current);
+            }
+            
+            U value = parse_unsigned<U>();
+            return negative ? T(U(0) - value) : T(value);
+        }
+
+        //The remaining (unconsumed) text
+        std::string_view rest() const{
+            return std::string_view(current, end - current);
+        }
+
+    private:
+        static bool is_digit(char c){
+            return c >= '0' && c <= '9';
+        }
+
+        //The character before the digits is a minus sign (and not a separator
+        //between two numbers, such as in "2-4")
+        bool is_sign(const char* digits) const{
+            if(digits == begin || digits[-1] != '-'){
+                return false;
+            }
+            return (digits - 1 == begin) || !is_digit(digits[-2]);
+        }
+
+        //Parse the digits at the current position. Uses the SWAR routine when
+        //at least 8 bytes can be read, and falls back to a scalar loop near the
+        //end of the text
+        template<typename U>
+        U parse_unsigned(){
+            U value = 0;
+        #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            while(end - current >= 8){
+                uint64_t chunk;
+                std::memcpy(&chunk, current, 8);
+                uint64_t chunk_value;
+                int n_digits = parse_digits_swar(chunk, chunk_value);
+                value = value * pow10[n_digits] + U(chunk_value);
+                current += n_digits;
+                if(n_digits < 8){
+                    return value;
+                }
+            }
+        #endif
+            while(current < end && is_digit(*current)){
+                value = value*10 + U(*current - '0');
+                current++;
+            }
+            return value;
+        }
+
+        static constexpr uint64_t pow10[9] = {
+            1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL
+        };
+
+        const char* begin;      //Start of the text
+        const char* current;    //Current read position
+        const char* end;        //End of the text
+    };
+
+    //Convert text to an integer, without creating a temporary std::string.
+    //Any leading non-digit characters (such as spaces) are skipped, parsing
+    //stops at the first non-digit. Throws if no number could be parsed.
+    template<typename T = int>
+    T to_int(std::string_view text){
+        return Scanner(text).next_int<T>();
+    }
+}
+
+/*
+    Instrumentation: scoped timers and event counters for the hot loops.
+
+        AOC_SCOPE("name");          //Time the enclosing scope
+        AOC_COUNT("name");          //Count an event
+        AOC_COUNT_ADD("name", n);   //Count n events
+
+    These macros compile to nothing, unless AOC_INSTRUMENT is defined (cmake
+    option AOC_INSTRUMENT). When enabled, every thread aggregates its own
+    statistics (no locking on the hot path), and the totals over all threads
+    are written to stderr at exit. If the AOC_INSTRUMENT_JSON environment
+    variable is set, the summary is also exported as JSON to that file.
+
+    Recursive scopes (such as pressure_released in puzzle 16) are only timed at
+    the outermost level, so the time is not counted more than once. The number
+    of calls does include the recursive calls.
+*/
+#ifdef AOC_INSTRUMENT
+#include <mutex>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+
+namespace aoc::instrument{
+
+    enum class Kind{
+        scope,
+        counter
+    };
+
+    //Statistics of a single scope or counter
+    struct Statistic{
+        long long count = 0;    //Number of calls / events
+        long long ns    = 0;    //Time spent in the scope (scopes only)
+        int       depth = 0;    //Current recursion depth (scopes only)
+    };
+
+    class ThreadStatistics;
+
+    //Global list of all scopes and counters, and of the threads that record them
+    class Registry{
+    public:
+        //The registry is never destroyed: the threads of aoc::TaskPool::global()
+        //can outlive the static objects, and still merge their statistics
+        //when they exit. The summary is printed by a static Reporter instead.
+        static Registry& get(){
+            static Registry* registry = new Registry;
+            static Reporter reporter;
+            return *registry;
+        }
+
+        //Identifier of a scope or counter. Every call site looks this up once.
+        size_t id(const char* name, Kind kind){
+            std::lock_guard<std::mutex> lock(mutex);
+            for(size_t i = 0; i<names.size(); i++){
+                if(names[i].first == name && names[i].second == kind){
+                    return i;
+                }
+            }
+            names.emplace_back(name,kind);
+            return names.size()-1;
+        }
+
+        void add_thread(ThreadStatistics* thread){
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.push_back(thread);
+            n_threads++;
+        }
+
+        //A thread exits: keep its statistics
+        void remove_thread(ThreadStatistics* thread, const std::vector<Statistic>& statistics){
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.erase(std::remove(threads.begin(),threads.end(),thread),threads.end());
+            merge(totals,statistics);
+        }
+
+    private:
+        Registry() = default;
+
+        //Prints the summary at exit (threads that are still running by then
+        //are idle, and are included as well)
+        struct Reporter{
+            ~Reporter(){
+                Registry::get().report();
+            }
+        };
+
+        static void merge(std::vector<Statistic>& target, const std::vector<Statistic>& source){
+            if(target.size() < source.size()){
+                target.resize(source.size());
+            }
+            for(size_t i = 0; i<source.size(); i++){
+                target[i].count += source[i].count;
+                target[i].ns    += source[i].ns;
+            }
+        }
+
+        //Print (and export) the totals over all threads
+        void report();
+
+        std::mutex mutex;
+        std::vector<std::pair<std::string,Kind>> names;
+        std::vector<ThreadStatistics*> threads;     //Threads that are still running
+        std::vector<Statistic> totals;              //Threads that have finished
+        int n_threads = 0;
+    };
+
+    //Statistics recorded by a single thread
+    class ThreadStatistics{
+    public:
+        ThreadStatistics(){
+            Registry::get().add_thread(this);
+        }
+
+        ~ThreadStatistics(){
+            Registry::get().remove_thread(this,statistics);
+        }
+
+        Statistic& operator[](size_t id){
+            if(id >= statistics.size()){
+                statistics.resize(id+1);
+            }
+            return statistics[id];
+        }
+
+        const std::vector<Statistic>& all() const{
+            return statistics;
+        }
+
+    private:
+        std::vector<Statistic> statistics;
+    };
+
+    inline ThreadStatistics& this_thread(){
+        thread_local ThreadStatistics statistics;
+        return statistics;
+    }
+
+    inline void Registry::report(){
+        std::lock_guard<std::mutex> lock(mutex);
+        //Threads that never exited (e.g. the workers of aoc::TaskPool) are idle by now
+        std::vector<Statistic> statistics = totals;
+        for(const ThreadStatistics* thread : threads){
+            merge(statistics,thread->all());
+        }
+        statistics.resize(names.size());
+
+        std::cerr << "aoc_instrument summary (" << n_threads << " thread" << (n_threads == 1 ? "" : "s") << ")" << std::endl;
+        for(size_t i = 0; i<names.size(); i++){
+            std::cerr << "  " << std::left << std::setw(8) << (names[i].second == Kind::scope ? "scope" : "counter")
+                      << std::setw(32) << names[i].first << std::right << std::setw(16) << statistics[i].count;
+            if(names[i].second == Kind::scope){
+                std::cerr << std::setw(14) << std::fixed << std::setprecision(3) << statistics[i].ns/1e6 << " ms";
+            }
+            std::cerr << std::endl;
+        }
+
+        const char* json_file = std::getenv("AOC_INSTRUMENT_JSON");
+        if(json_file != nullptr){
+            std::ofstream json(json_file);
+            json << "{\"threads\": " << n_threads << ", \"scopes\": {";
+            bool first = true;
+            for(size_t i = 0; i<names.size(); i++){
+                if(names[i].second == Kind::scope){
+                    json << (first ? "" : ", ") << "\"" << names[i].first << "\": {\"calls\": " << statistics[i].count << ", \"ns\": " << statistics[i].ns << "}";
+                    first = false;
+                }
+            }
+            json << "}, \"counters\": {";
+            first = true;
+            for(size_t i = 0; i<names.size(); i++){
+                if(names[i].second == Kind::counter){
+                    json << (first ? "" : ", ") << "\"" << names[i].first << "\": " << statistics[i].count;
+                    first = false;
+                }
+            }
+            json << "}}" << std::endl;
+        }
+    }
+
+    //Times the scope it lives in (see AOC_SCOPE)
+    class ScopeTimer{
+    public:
+        explicit ScopeTimer(size_t id) : id(id){
+            Statistic& statistic = this_thread()[id];
+            statistic.count++;
+            if(statistic.depth++ == 0){
+                start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~ScopeTimer(){
+            //Look up again: the statistics may have been resized in the meantime
+            Statistic& statistic = this_thread()[id];
+            if(--statistic.depth == 0){
+                statistic.ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            }
+        }
+
+        ScopeTimer(const ScopeTimer&) = delete;
+        ScopeTimer& operator=(const ScopeTimer&) = delete;
+
+    private:
+        size_t id;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+#define AOC_INSTRUMENT_CONCAT_(a,b) a##b
+#define AOC_INSTRUMENT_CONCAT(a,b) AOC_INSTRUMENT_CONCAT_(a,b)
+
+#define AOC_SCOPE(name)                                                                   \
+    static const size_t AOC_INSTRUMENT_CONCAT(aoc_scope_id_,__LINE__) =                   \
+        aoc::instrument::Registry::get().id(name,aoc::instrument::Kind::scope);           \
+    aoc::instrument::ScopeTimer AOC_INSTRUMENT_CONCAT(aoc_scope_,__LINE__)(AOC_INSTRUMENT_CONCAT(aoc_scope_id_,__LINE__))
+
+#define AOC_COUNT_ADD(name,n)                                                             \
+    do{                                                                                   \
+        static const size_t aoc_counter_id =                                              \
+            aoc::instrument::Registry::get().id(name,aoc::instrument::Kind::counter);     \
+        aoc::instrument::this_thread()[aoc_counter_id].count += (n);                      \
+    }while(0)
+
+#define AOC_COUNT(name) AOC_COUNT_ADD(name,1)
+
+#else
+#define AOC_SCOPE(name)       ((void)0)
+#define AOC_COUNT_ADD(name,n) ((void)0)
+#define AOC_COUNT(name)       ((void)0)
+#endif
\ No newline at end of file
@@ -0,0 +1,712 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <list>
+#include <limits>
+#include "aoc_utility.hpp"
+#include "aoc_arena.hpp"
+#include "aoc_grid.hpp"
+#include "aoc_search.hpp"
+#include "puzzle3.hpp"
+#include "puzzle6.hpp"
+#include "puzzle9.hpp"
+#include "puzzle13.hpp"
+#include "puzzle17.hpp"
+#include "puzzle21.hpp"
+#include "puzzle22.hpp"
+
+/*
+    Micro benchmarks of the hot kernels of the puzzles. Every kernel runs a
+    single operation (parse one line, compare one packet pair, ...) on
+    synthetic data that is generated up front with a fixed seed, so the
+    results are repeatable and independent of the puzzle inputs.
+
+    A kernel is timed in batches: the batch size is doubled until one batch
+    takes at least --batch-ms, which hides the overhead and resolution of the
+    clock. Then --samples batches are timed. Samples that are more than 3
+    (scaled) median absolute deviations away from the median are rejected as
+    outliers (interrupts, frequency changes), and the median of the others is
+    reported in ns per operation.
+
+    Some kernels have a reference: a straightforward alternative (e.g.
+    std::stoll for aoc::to_int), which is reported as a ratio. With --json the
+    results are saved, and a saved file can be compared to with --compare.
+*/
+
+using rng_type = std::mt19937_64;
+
+//Keep the compiler from optimizing away a value that is computed but not used
+template<typename T>
+inline void do_not_optimize(const T& value){
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+//A benchmarked operation. The kernel is set up once (when the benchmarks
+//are selected), and run(n) performs the operation n times.
+struct Kernel{
+    std::string name;
+    std::string reference;                  //Name of the kernel to compare to (if any)
+    std::function<void(long long)> run;
+};
+
+//Measurement settings
+struct Settings{
+    double batch_ms = 2;                    //Minimum duration of a batch
+    int samples     = 25;                   //Number of timed batches
+    std::string json_file;
+    std::string compare_file;
+    std::vector<std::string> filters;
+};
+
+//Result of a kernel, in ns per operation
+struct Result{
+    double ns_per_op = 0;                   //Median of the accepted samples
+    double min       = 0;
+    double spread    = 0;                   //Median absolute deviation, relative to the median
+    long long batch  = 0;                   //Operations per batch
+    int rejected     = 0;                   //Number of outliers
+};
+
+//Random integer in [lo,hi] (inclusive)
+long long random_int(rng_type& rng, long long lo, long long hi){
+    return std::uniform_int_distribution<long long>(lo,hi)(rng);
+}
+
+//Median of a (non-empty) series
+double median(std::vector<double> values){
+    std::sort(values.begin(),values.end());
+    size_t n = values.size();
+    return (n % 2 == 1) ? values[n/2] : (values[n/2-1] + values[n/2])/2;
+}
+
+//Time n operations, in nanoseconds
+double time_batch(const Kernel& kernel, long long n){
+    auto start = std::chrono::steady_clock::now();
+    kernel.run(n);
+    auto stop  = std::chrono::steady_clock::now();
+    return std::chrono::duration<double,std::nano>(stop - start).count();
+}
+
+Result measure(const Kernel& kernel, const Settings& settings){
+    Result result;
+
+    //Warm up, and find the batch size
+    long long n = 1;
+    while(time_batch(kernel,n) < settings.batch_ms*1e6 && n < (1LL << 40)){
+        n *= 2;
+    }
+    result.batch = n;
+
+    std::vector<double> samples;
+    for(int i = 0; i<settings.samples; i++){
+        samples.push_back(time_batch(kernel,n)/n);
+    }
+
+    //Reject the outliers: more than 3 standard deviations from the median,
+    //with the standard deviation estimated from the median absolute deviation
+    double center = median(samples);
+    std::vector<double> deviations;
+    for(double sample : samples){
+        deviations.push_back(std::abs(sample - center));
+    }
+    double mad = median(deviations);
+    std::vector<double> accepted;
+    for(double sample : samples){
+        if(mad == 0 || std::abs(sample - center) <= 3*1.4826*mad){
+            accepted.push_back(sample);
+        }
+    }
+    result.rejected  = samples.size() - accepted.size();
+    result.ns_per_op = median(accepted);
+    result.min       = *std::min_element(accepted.begin(),accepted.end());
+    result.spread    = (result.ns_per_op > 0) ? mad/result.ns_per_op : 0;
+    return result;
+}
+
+//Synthetic input: lines of numbers, like the input of puzzle 1
+std::string number_lines(rng_type& rng, int n_lines){
+    std::string text;
+    for(int i = 0; i<n_lines; i++){
+        text += std::to_string(random_int(rng,1000,70000)) + "\n";
+    }
+    return text;
+}
+
+//Synthetic packet (puzzle 13): a list of numbers and nested lists
+std::string random_packet(rng_type& rng, int depth){
+    std::string packet = "[";
+    int n_items = random_int(rng,0,5);
+    for(int i = 0; i<n_items; i++){
+        if(i > 0){
+            packet += ",";
+        }
+        if(depth > 0 && random_int(rng,0,3) == 0){
+            packet += random_packet(rng,depth-1);
+        }else{
+            packet += std::to_string(random_int(rng,0,10));
+        }
+    }
+    return packet + "]";
+}
+
+//Synthetic height map (puzzle 12), like the one of gen_inputs: the terrain
+//climbs towards E, with random pits, and a route from S to E without pits
+std::string height_map(rng_type& rng, int size){
+    int end_row = random_int(rng,size/4,3*size/4);
+    int end_col = random_int(rng,size/4,3*size/4);
+    double slope = std::max(1.0,(end_row + end_col)/25.0);
+    std::string text;
+    for(int row = 0; row<size; row++){
+        for(int col = 0; col<size; col++){
+            int height = std::max(0,25 - int((std::abs(row-end_row) + std::abs(col-end_col))/slope));
+            bool on_route = (row == 0 && col <= end_col) || (col == end_col && row <= end_row);
+            if(!on_route && random_int(rng,0,4) == 0){
+                height = random_int(rng,0,height);
+            }
+            text += (row == 0 && col == 0) ? 'S' : (row == end_row && col == end_col) ? 'E' : char('a' + height);
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+//Puzzle 12 before aoc::search (the reference of the p12 kernels): A* over a
+//graph of nodes, with a std::list as open set
+namespace old_puzzle12{
+    using pos_type = std::array<int,2>;
+
+    struct Node{
+        pos_type pos;
+        int height = 0;
+        double gscore = std::numeric_limits<double>::infinity();
+        double fscore = std::numeric_limits<double>::infinity();
+        Node* camefrom = nullptr;
+        std::vector<Node*> neighbors;
+    };
+
+    double heuristic(const Node* node, const pos_type& target){
+        return std::abs(node->pos[0] - target[0]) + std::abs(node->pos[1] - target[1]);
+    }
+
+    double cost(const Node* current, const Node* neighbor){
+        return (neighbor->height - current->height <= 1) ? 1.0 : 1000;
+    }
+
+    //The graph of a height map (converted like puzzle 12 does)
+    std::vector<Node> make_graph(const aoc::Grid<char>& heights){
+        const int n_rows = heights.rows();
+        const int n_cols = heights.cols();
+        std::vector<Node> nodes(n_rows*n_cols);
+        for(int row = 0; row<n_rows; row++){
+            for(int col = 0; col<n_cols; col++){
+                Node& node  = nodes[row*n_cols + col];
+                node.pos    = {row,col};
+                node.height = heights(row,col);
+                if(col>0){           node.neighbors.push_back(&nodes[row*n_cols + col-1]);}
+                if(col<n_cols-1){    node.neighbors.push_back(&nodes[row*n_cols + col+1]);}
+                if(row>0){           node.neighbors.push_back(&nodes[(row-1)*n_cols + col]);}
+                if(row<n_rows-1){    node.neighbors.push_back(&nodes[(row+1)*n_cols + col]);}
+            }
+        }
+        return nodes;
+    }
+
+    //Number of steps from the start node to the goal
+    int A_Star(std::vector<Node>& nodes, Node* startnode, const pos_type& goal){
+        for(Node& node : nodes){
+            node.gscore   = std::numeric_limits<double>::infinity();
+            node.fscore   = std::numeric_limits<double>::infinity();
+            node.camefrom = nullptr;
+        }
+        startnode->gscore = 0;
+        startnode->fscore = heuristic(startnode,goal);
+        std::list<Node*> openSet;
+        openSet.push_back(startnode);
+        while(!openSet.empty()){
+            auto it = std::min_element(openSet.begin(),openSet.end(),[](const Node* a, const Node* b){
+                return a->fscore < b->fscore;
+            });
+            Node* current = *it;
+            openSet.erase(it);
+            if(current->pos == goal){
+                int n_steps = 0;
+                for(Node* node = current->camefrom; node != nullptr; node = node->camefrom){
+                    n_steps++;
+                }
+                return n_steps;
+            }
+            for(Node* neighbor : current->neighbors){
+                double tentative_gScore = current->gscore + cost(current,neighbor);
+                if(tentative_gScore < neighbor->gscore){
+                    neighbor->camefrom = current;
+                    neighbor->gscore   = tentative_gScore;
+                    neighbor->fscore   = tentative_gScore + heuristic(neighbor,goal);
+                    if(std::find(openSet.begin(),openSet.end(),neighbor) == openSet.end()){
+                        openSet.push_back(neighbor);
+                    }
+                }
+            }
+        }
+        throw std::runtime_error("A* failed to find a route");
+    }
+}
+
+//All kernels, with their data
+std::vector<Kernel> make_kernels(){
+    std::vector<Kernel> kernels;
+    rng_type rng(2022);
+
+    //Line splitting: one line per operation
+    {
+        auto text = std::make_shared<std::string>(number_lines(rng,4096));
+        auto input = std::make_shared<aoc::InputView>(aoc::InputView::FromMemory(),*text);
+        kernels.push_back({"lines/InputView::getline","lines/std::getline",[input](long long n){
+            std::string_view line;
+            for(long long i = 0; i<n; i++){
+                if(!input->getline(line)){
+                    input->rewind();
+                    input->getline(line);
+                }
+                do_not_optimize(line);
+            }
+        }});
+        auto stream = std::make_shared<std::istringstream>(*text);
+        kernels.push_back({"lines/std::getline","",[stream](long long n){
+            std::string line;
+            for(long long i = 0; i<n; i++){
+                if(!std::getline(*stream,line)){
+                    stream->clear();
+                    stream->seekg(0);
+                    std::getline(*stream,line);
+                }
+                do_not_optimize(line);
+            }
+        }});
+    }
+
+    //Integer parsing: one number per operation
+    {
+        auto numbers = std::make_shared<std::vector<std::string>>();
+        for(int i = 0; i<4096; i++){
+            numbers->push_back(std::to_string(random_int(rng,0,1LL << random_int(rng,4,40))));
+        }
+        kernels.push_back({"parse/aoc::to_int","parse/std::stoll",[numbers](long long n){
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(aoc::to_int<long long>((*numbers)[i & 4095]));
+            }
+        }});
+        kernels.push_back({"parse/std::stoll","",[numbers](long long n){
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(std::stoll((*numbers)[i & 4095]));
+            }
+        }});
+    }
+
+    //Puzzle 3: the priority of an item, and filling a rucksack (one line)
+    {
+        const std::string items = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        auto rucksacks = std::make_shared<std::vector<std::string>>();
+        for(int i = 0; i<1024; i++){
+            std::string rucksack;
+            int length = 2*random_int(rng,8,24);
+            for(int j = 0; j<length; j++){
+                rucksack += items[random_int(rng,0,items.size()-1)];
+            }
+            rucksacks->push_back(rucksack);
+        }
+        //The items of all rucksacks, one after the other
+        auto all_items = std::make_shared<std::string>();
+        for(const std::string& rucksack : *rucksacks){
+            *all_items += rucksack;
+        }
+        kernels.push_back({"p3/priority","",[all_items](long long n){
+            size_t j = 0;
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(puzzle3::priority((*all_items)[j]));
+                if(++j == all_items->size()){
+                    j = 0;
+                }
+            }
+        }});
+        kernels.push_back({"p3/fill_rucksack","",[rucksacks](long long n){
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(puzzle3::fill_rucksack((*rucksacks)[i & 1023]));
+            }
+        }});
+    }
+
+    //Puzzle 6: check a window of 14 characters (part 2), sliding over the text.
+    //The reference keeps a bit mask per window instead of a std::set. Both
+    //check the same precomputed windows, so only the check itself is timed.
+    {
+        std::string text;
+        for(int i = 0; i<4096 + 13; i++){
+            text += char('a' + random_int(rng,0,25));
+        }
+        auto windows = std::make_shared<std::vector<std::deque<char>>>();
+        for(int i = 0; i<4096; i++){
+            windows->emplace_back(text.begin() + i,text.begin() + i + 14);
+        }
+        kernels.push_back({"p6/all_chars_unique","p6/bit mask",[windows](long long n){
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(puzzle6::all_chars_unique((*windows)[i & 4095]));
+            }
+        }});
+        kernels.push_back({"p6/bit mask","",[windows](long long n){
+            for(long long i = 0; i<n; i++){
+                uint32_t mask = 0;
+                for(char c : (*windows)[i & 4095]){
+                    mask |= 1u << (c - 'a');
+                }
+                do_not_optimize(__builtin_popcount(mask) == 14);
+            }
+        }});
+    }
+
+    //Puzzle 9: move a tail after its head, for heads up to 2 steps away
+    {
+        auto pairs = std::make_shared<std::vector<std::pair<puzzle9::node,puzzle9::node>>>();
+        for(int i = 0; i<1024; i++){
+            puzzle9::node head{int(random_int(rng,-2,2)),int(random_int(rng,-2,2))};
+            pairs->push_back({head,puzzle9::node{}});
+        }
+        kernels.push_back({"p9/update_tail","",[pairs](long long n){
+            for(long long i = 0; i<n; i++){
+                const auto& pair = (*pairs)[i & 1023];
+                puzzle9::node tail = pair.second;
+                puzzle9::update_tail(pair.first,tail);
+                do_not_optimize(tail);
+            }
+        }});
+    }
+
+    //Puzzle 12: the shortest route from S to E on a 200x200 height map (one
+    //search per operation), with the searches of aoc::search (as puzzle 12
+    //uses them), compared to the A* that puzzle 12 used before
+    {
+        struct HeightMap{
+            aoc::Grid<char> heights;
+            int start = -1;
+            int end   = -1;
+        };
+        auto map = std::make_shared<HeightMap>();
+        map->heights = aoc::Grid<char>::from_text(height_map(rng,200),1,127);
+        map->heights.for_each_cell([&](auto index){
+            char& c = map->heights[index];
+            if(c == 'S'){
+                map->start = index;
+                c = 'a';
+            }else if(c == 'E'){
+                map->end = index;
+                c = 'z';
+            }
+            c -= 'a';
+        });
+
+        //You can move to a neighbour that is at most 1 higher (never onto the border)
+        auto neighbours = [map](int node, auto&& visit){
+            for(auto offset : map->heights.neighbour_offsets()){
+                if(map->heights[node + offset] - map->heights[node] <= 1){
+                    visit(node + offset,1);
+                }
+            }
+        };
+        auto heuristic = [map](int node){
+            auto pos = map->heights.coords(node);
+            auto end = map->heights.coords(map->end);
+            return std::abs(pos[0] - end[0]) + std::abs(pos[1] - end[1]);
+        };
+        auto is_end = [map](int node){
+            return node == map->end;
+        };
+        const int n_nodes = map->heights.storage_size();
+
+        kernels.push_back({"p12/A* (radix heap)","p12/old A*",[=](long long n){
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(aoc::search::astar(n_nodes,{map->start},neighbours,heuristic,is_end).distance[map->end]);
+            }
+        }});
+        kernels.push_back({"p12/A* (binary heap)","p12/old A*",[=](long long n){
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(aoc::search::astar<aoc::search::BinaryHeap>(n_nodes,{map->start},neighbours,heuristic,is_end).distance[map->end]);
+            }
+        }});
+        kernels.push_back({"p12/Dijkstra (radix heap)","p12/old A*",[=](long long n){
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(aoc::search::dijkstra(n_nodes,{map->start},neighbours,is_end).distance[map->end]);
+            }
+        }});
+        kernels.push_back({"p12/BFS","p12/old A*",[=](long long n){
+            auto unit_neighbours = [&](int node, auto&& visit){
+                neighbours(node,[&](int neighbour, int){ visit(neighbour); });
+            };
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(aoc::search::bfs(n_nodes,{map->start},unit_neighbours,is_end).distance[map->end]);
+            }
+        }});
+        auto nodes = std::make_shared<std::vector<old_puzzle12::Node>>(old_puzzle12::make_graph(map->heights));
+        kernels.push_back({"p12/old A*","",[map,nodes](long long n){
+            auto start = map->heights.coords(map->start);
+            auto end   = map->heights.coords(map->end);
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(old_puzzle12::A_Star(*nodes,&(*nodes)[start[0]*map->heights.cols() + start[1]],{end[0],end[1]}));
+            }
+        }});
+    }
+
+    //Puzzle 13: compare a pair of packets
+    {
+        auto arena   = std::make_shared<aoc::Arena>();
+        auto packets = std::make_shared<std::vector<puzzle13::list_or_num>>();
+        for(int i = 0; i<2*512; i++){
+            std::string packet = random_packet(rng,3);
+            puzzle13::List list(arena.get());
+            puzzle13::parse(&list,std::string_view(packet).substr(1,packet.size()-2));
+            packets->emplace_back(std::move(list));
+        }
+        kernels.push_back({"p13/sorted","",[arena,packets](long long n){
+            for(long long i = 0; i<n; i++){
+                size_t pair = 2*(i & 511);
+                do_not_optimize(puzzle13::sorted((*packets)[pair],(*packets)[pair+1]));
+            }
+        }});
+    }
+
+    //Puzzle 17: check a shape at a position near the top of a half filled map
+    {
+        auto shapes = std::make_shared<std::array<puzzle17::Shape,puzzle17::N_shapes>>(puzzle17::make_shapes());
+        auto map    = std::make_shared<puzzle17::Map>();
+        for(int row = 0; row<64; row++){
+            map->blocks.push_back(random_int(rng,0,(1 << puzzle17::N_cols) - 1));
+        }
+        struct Drop{
+            int shape;
+            puzzle17::pos_type pos;
+        };
+        auto drops = std::make_shared<std::vector<Drop>>();
+        for(int i = 0; i<1024; i++){
+            int shape = random_int(rng,0,puzzle17::N_shapes-1);
+            drops->push_back({shape,{random_int(rng,-1,puzzle17::N_cols - (*shapes)[shape].cols + 1),random_int(rng,-1,59)}});
+        }
+        kernels.push_back({"p17/detect_collision","",[shapes,map,drops](long long n){
+            for(long long i = 0; i<n; i++){
+                const Drop& drop = (*drops)[i & 1023];
+                do_not_optimize(puzzle17::detect_collision(*map,(*shapes)[drop.shape],drop.pos));
+            }
+        }});
+    }
+
+    //Puzzle 21: resolve the root of a balanced tree of 1023 monkeys
+    {
+        auto monkeys = std::make_shared<puzzle21::monkey_list>();
+        const int n_monkeys = 1023;
+        const std::string operations = "+-*";
+        for(int i = 0; i<n_monkeys; i++){
+            std::string name = (i == 0) ? "root" : "m" + std::to_string(i);
+            if(2*i + 2 < n_monkeys){
+                std::string left  = "m" + std::to_string(2*i + 1);
+                std::string right = "m" + std::to_string(2*i + 2);
+                (*monkeys)[name] = puzzle21::MathMonkey{operations[random_int(rng,0,2)],left,right};
+            }else{
+                (*monkeys)[name] = puzzle21::YellMonkey{random_int(rng,1,9)};
+            }
+        }
+        kernels.push_back({"p21/resolve_monkey (1023 monkeys)","",[monkeys](long long n){
+            const std::string root = "root";
+            for(long long i = 0; i<n; i++){
+                do_not_optimize(puzzle21::resolve_monkey<long long>(*monkeys,root));
+            }
+        }});
+    }
+
+    //Puzzle 22: rotate a position on a cube face, and round it to the grid
+    {
+        auto positions = std::make_shared<std::vector<std::pair<int,Eigen::Vector3d>>>();
+        for(int i = 0; i<1024; i++){
+            Eigen::Vector3d pos(random_int(rng,-25,25) + 0.5,random_int(rng,-25,25) + 0.5,0);
+            positions->push_back({int(random_int(rng,0,3)),pos});
+        }
+        kernels.push_back({"p22/Rz+round","",[positions](long long n){
+            for(long long i = 0; i<n; i++){
+                const auto& position = (*positions)[i & 1023];
+                Eigen::Vector3d pos = puzzle22::Rz(position.first*90)*position.second;
+                int row = std::round(pos[1]);
+                int col = std::round(pos[0]);
+                do_not_optimize(row);
+                do_not_optimize(col);
+            }
+        }});
+    }
+
+    return kernels;
+}
+
+//The ns per operation of every kernel in a file written with --json
+std::map<std::string,double> read_results(const std::string& filename){
+    std::ifstream file(filename);
+    if(!file){
+        throw std::runtime_error("Could not open " + filename);
+    }
+    std::map<std::string,double> results;
+    std::string line;
+    while(std::getline(file,line)){
+        size_t name_pos  = line.find("\"kernel\": \"");
+        size_t value_pos = line.find("\"ns_per_op\": ");
+        if(name_pos == std::string::npos || value_pos == std::string::npos){
+            continue;
+        }
+        name_pos += 11;
+        std::string name = line.substr(name_pos,line.find('"',name_pos) - name_pos);
+        results[name] = std::stod(line.substr(value_pos + 13));
+    }
+    return results;
+}
+
+void print_usage(){
+    std::cout << "Usage: ./aoc_microbench [--batch-ms T] [--samples N] [--json <file>] [--compare <file>] [--list] [kernel ...]" << std::endl;
+    std::cout << "Kernels are selected by name prefix, e.g. p13 or parse/. With --compare, the" << std::endl;
+    std::cout << "results are compared to a file that was written by an earlier --json run." << std::endl;
+}
+
+int main(int argc, char *argv[]){
+    Settings settings;
+    bool list = false;
+
+    for(int i = 1; i<argc; i++){
+        std::string arg = argv[i];
+        if((arg == "--batch-ms" || arg == "--samples" || arg == "--json" || arg == "--compare") && i+1 >= argc){
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        if(arg == "--batch-ms"){
+            settings.batch_ms = std::stod(argv[++i]);
+        }else if(arg == "--samples"){
+            settings.samples = std::max(1,std::stoi(argv[++i]));
+        }else if(arg == "--json"){
+            settings.json_file = argv[++i];
+        }else if(arg == "--compare"){
+            settings.compare_file = argv[++i];
+        }else if(arg == "--list"){
+            list = true;
+        }else if(arg == "--help" || arg == "-h"){
+            print_usage();
+            return 0;
+        }else{
+            settings.filters.push_back(arg);
+        }
+    }
+
+    std::vector<Kernel> kernels = make_kernels();
+    if(list){
+        for(const auto& kernel : kernels){
+            std::cout << kernel.name << std::endl;
+        }
+        return 0;
+    }
+
+    std::map<std::string,double> baseline;
+    if(!settings.compare_file.empty()){
+        baseline = read_results(settings.compare_file);
+    }
+
+    auto selected = [&settings](const Kernel& kernel){
+        if(settings.filters.empty()){
+            return true;
+        }
+        for(const auto& filter : settings.filters){
+            if(kernel.name.compare(0,filter.size(),filter) == 0){
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::cout << std::left << std::setw(36) << "kernel" << std::right
+              << std::setw(12) << "ns/op" << std::setw(12) << "min" << std::setw(9) << "+/-"
+              << std::setw(10) << "outliers" << std::setw(14) << "vs reference";
+    if(!baseline.empty()){
+        std::cout << std::setw(14) << "vs baseline";
+    }
+    std::cout << std::endl;
+
+    std::map<std::string,Result> results;
+    std::stringstream json;
+    json << "{\n  \"batch_ms\": " << settings.batch_ms << ",\n  \"samples\": " << settings.samples << ",\n  \"results\": [";
+    bool first_result = true;
+    for(const auto& kernel : kernels){
+        if(!selected(kernel)){
+            continue;
+        }
+        //A kernel may already have been measured as the reference of another
+        if(results.find(kernel.name) == results.end()){
+            results[kernel.name] = measure(kernel,settings);
+        }
+        const Result result = results[kernel.name];
+
+        std::cout << std::left << std::setw(36) << kernel.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << result.ns_per_op << std::setw(12) << result.min
+                  << std::setw(8) << std::setprecision(1) << 100*result.spread << "%"
+                  << std::setw(10) << result.rejected;
+
+        //The reference is measured now if it was not measured yet (also if it
+        //was not selected itself)
+        std::ostringstream ratio;
+        if(!kernel.reference.empty()){
+            auto reference = std::find_if(kernels.begin(),kernels.end(),[&kernel](const Kernel& k){ return k.name == kernel.reference; });
+            if(reference != kernels.end()){
+                if(results.find(reference->name) == results.end()){
+                    results[reference->name] = measure(*reference,settings);
+                }
+                //More digits for kernels that are orders of magnitude faster
+                double speed = result.ns_per_op/results[reference->name].ns_per_op;
+                ratio << std::fixed << std::setprecision(speed < 0.1 ? 4 : 2) << speed << "x";
+            }
+        }
+        std::cout << std::setw(14) << ratio.str();
+
+        if(!baseline.empty()){
+            std::ostringstream change;
+            auto saved = baseline.find(kernel.name);
+            if(saved != baseline.end() && saved->second > 0){
+                change << std::showpos << std::fixed << std::setprecision(1) << 100*(result.ns_per_op/saved->second - 1) << "%";
+            }else{
+                change << "-";
+            }
+            std::cout << std::setw(14) << change.str();
+        }
+        std::cout << std::endl;
+
+        json << (first_result ? "\n" : ",\n");
+        json << "    {\"kernel\": \"" << kernel.name << "\", \"ns_per_op\": " << result.ns_per_op
+             << ", \"min_ns\": " << result.min << ", \"mad\": " << result.spread
+             << ", \"rejected\": " << result.rejected << ", \"batch\": " << result.batch << "}";
+        first_result = false;
+    }
+    json << "\n  ]\n}\n";
+
+    if(settings.json_file == "-"){
+        std::cout << json.str();
+    }else if(!settings.json_file.empty()){
+        std::ofstream json_stream(settings.json_file);
+        json_stream << json.str();
+        std::cout << "JSON results written to " << settings.json_file << std::endl;
+    }
+    return 0;
+}
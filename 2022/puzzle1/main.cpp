@@ -1,34 +1,19 @@
 #include <iostream>
-#include <fstream>
-#include <vector>
-#include <algorithm>
+#include "aoc_utility.hpp"
+#include "puzzle1.hpp"
 
-/*
-    The Christmas elves are going on a hike, and need to determine who has the
-    most food (calorie-wise).
-*/
-int main(){
-    //Load input file (this file is copied to the build directory)
-    std::fstream infs("input.txt");
-    
-    //Calculate food per elf
-    std::vector<int> food;
-    int calories = 0;
-    std::string line;
-    while(std::getline(infs,line)){
-        if(line == ""){
-            //Empty line = new elf
-            food.push_back(calories);
-            calories = 0;
-        }else{
-            calories += std::atoi(line.c_str());
-        }
-    }
+//Calorie Counting
+//Both parts are always solved together, the part argument is accepted for
+//consistency with the other puzzles
+// Run as: ./puzzle1       or      ./puzzle1 1      or      ./puzzle1 2
+// Options: --input <path> (or - for stdin), --repeat N, --quiet, --cache,
+//          --batch <dir|listfile>, --stream (single pass, constant memory)
+int main(int argc, char *argv[]){
 
-    //Sorting is overkill for part 1, but makes part 2 very simple
-    std::sort(food.begin(),food.end(),std::greater<int>());
-    std::cout << "Elf with most food has: " << food[0] << " Calories" << std::endl;
-    std::cout << "Top three elves combined have: " << food[0] + food[1] + food[2] << " Calories" << std::endl;
+    //Parse the program arguments: the part number (default: all), the input
+    //file (default: input.txt, which is copied to the build directory) and
+    //the run options
+    aoc::Options options = aoc::get_options(argc,argv);
 
-    return 0;
+    return aoc::run(options,puzzle1::solve,puzzle1::solve_stream);
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "puzzle1.hpp"
+#include <iostream>
+#include <array>
+#include "aoc_utility.hpp"
+
+namespace puzzle1{
+
+//The K largest totals seen so far, in decreasing order (0 if fewer were seen)
+template<int K>
+struct TopK{
+    std::array<int,K> values{};
+
+    void add(int value){
+        if(value <= values[K-1]){
+            return;
+        }
+        //Insert in order, the smallest value drops out
+        int i = K-1;
+        for(; i>0 && values[i-1] < value; i--){
+            values[i] = values[i-1];
+        }
+        values[i] = value;
+    }
+};
+
+//Print the answers of both parts
+void print_answers(const TopK<3>& food, std::ostream& out){
+    out << "Elf with most food has: " << food.values[0] << " Calories" << std::endl;
+    out << "Top three elves combined have: " << food.values[0] + food.values[1] + food.values[2] << " Calories" << std::endl;
+}
+
+/*
+    The Christmas elves are going on a hike, and need to determine who has the
+    most food (calorie-wise).
+*/
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    
+    //Calculate food per elf. Every elf is a block of lines, separated by an 
+    //empty line. Only the top three is kept.
+    TopK<3> food;
+    std::string_view block;
+    while(input.get_block(block)){
+        aoc::Scanner scanner(block);
+        int calories = 0;
+        while(!scanner.done()){
+            calories += scanner.next_int<unsigned>();
+        }
+        food.add(calories);
+    }
+
+    timer.phase("parse");
+
+    print_answers(food,out);
+
+    timer.phase("solve");
+}
+
+//The same, line by line
+void solve_stream(aoc::InputStream& input, std::ostream& out){
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //The input is parsed while solving, so only opening the input counts as parsing
+    timer.phase("parse");
+
+    TopK<3> food;
+    std::string_view line;
+    int calories = 0;
+    while(input.getline(line)){
+        //An empty line ends the elf
+        if(line.empty()){
+            food.add(calories);
+            calories = 0;
+            continue;
+        }
+        aoc::Scanner scanner(line);
+        while(!scanner.done()){
+            calories += scanner.next_int<unsigned>();
+        }
+    }
+    food.add(calories);
+
+    print_answers(food,out);
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "puzzle10.hpp"
+#include <iostream>
+#include <string>
+#include "aoc_utility.hpp"
+
+namespace puzzle10{
+
+//Determine if the current clock cycle is "interesting" (according to part 1)
+bool is_interesting_cycle(int clock){
+    return (clock - 20) % 40 == 0;
+}
+
+//Draw a pixel to the screen. 
+//Also loop around every 40th pixel
+void draw_CRT(std::ostream& out, const int clock, const int regX){
+    //Determine what column the current pixel goes into
+    //If the mask and current column overlap, draw a 
+    //lit pixel (#), else a dark pixel (.)
+    int column = (clock-1)%40;    
+    if(std::abs(column - regX) <= 1){
+        out << "#";
+    }else{
+        out << ".";
+    }
+    //Loop around every 40th pixel
+    if(column == 39){
+        out << std::endl;
+    }
+}
+
+//Run the program, line by line, and draw the screen while running. Input is
+//an aoc::InputView, or an aoc::InputStream (--stream): the input is only read once.
+template<typename Input>
+void run_program(Input& input, std::ostream& out){
+
+    int clock = 1;  //Clock counter
+    int regX  = 1;  //X register of the computer
+
+    //Answer for part 1
+    int signal_strength_sum = 0;
+
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //The input is parsed while solving, so only mapping the file counts as parsing
+    timer.phase("parse");
+    std::string_view line;
+    while(input.getline(line)){   
+        //Instruction is (in this case) always 4 letters long: either "addx" or "noop"
+        std::string_view instruction = line.substr(0,4); 
+
+        //Draw a pixel on the screen
+        draw_CRT(out, clock, regX);       
+        if(instruction == "noop"){
+            //For a no-op, only increment the clock
+            clock++;
+        }else if(instruction == "addx"){
+            //For an addx, increment the clock twice. Draw a pixel in between
+            //the increments. At the end of the second cycle, add to register X.
+            //Check at every clock increment whether it is an "interesting value". 
+            aoc::Scanner scanner(line);
+            scanner.expect("addx ");
+            int value = scanner.next_int<int>();
+            clock++;
+            if(is_interesting_cycle(clock)){
+                signal_strength_sum += clock*regX;
+            }            
+            draw_CRT(out, clock, regX);
+            clock++;
+            regX += value;
+        }           
+        
+        if(is_interesting_cycle(clock)){
+            signal_strength_sum += clock*regX;
+        }       
+    }   
+
+    out << "signal strength sum: " << signal_strength_sum << std::endl;
+    timer.phase("solve");
+}
+
+//Debug the communication device
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+    run_program(input,out);
+}
+
+void solve_stream(aoc::InputStream& input, std::ostream& out){
+    run_program(input,out);
+}
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+#include <ostream>
+#include "aoc_utility.hpp"
+
+//Cathode-Ray Tube
+namespace puzzle10{
+    //Solve the puzzle for the given input (both parts are always solved, the
+    //part number is ignored), and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Solve both parts in a single pass over the input, in constant memory
+    //(--stream), and write the results to out
+    void solve_stream(aoc::InputStream& input, std::ostream& out);
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "puzzle11.hpp"
+#include <iostream>
+#include <string>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <set>
+#include "aoc_utility.hpp"
+#include <cmath>
+
+namespace puzzle11{
+
+struct Monkey{  
+    int              id;                // Monkey ID
+    std::vector<long> items;            // List of items
+    char             operation;         // "+" or "*"
+    long              arg1 = -1;        // number, or -1 for "old"
+    long              arg2 = -1;        // number, or -1 for "old"
+    int              divisible_by;      // Test: divisible by this number??
+    int              monkey_if_true;    // Throw to this monkey if test is true
+    int              monkey_if_false;   // Throw to this monkey if test is false
+    int              activity=0;        // Number of inspected items
+};
+
+//Let the monkeys play with the items, and print the monkey business score.
+//The monkeys are passed by value, since every part starts from the input.
+template<int Part>
+void monkey_business(std::vector<Monkey> monkeys, int supermod, std::ostream& out){
+    //Run the 20 (part 1) or 10.000 (part 2) rounds
+    constexpr int Nrounds = (Part == 1) ? 20 : 10000;
+    for(int round = 0; round<Nrounds; round++){
+        for(Monkey& monkey: monkeys){
+            for(long item: monkey.items){
+                long old_val = item;
+                long new_val;                
+                long arg1 = (monkey.arg1 == -1) ? old_val : monkey.arg1;
+                long arg2 = (monkey.arg2 == -1) ? old_val : monkey.arg2;
+
+                //Do an addition or multiplication. Use the modulo to keep
+                //the operands small enough to avoid overflow
+                if(monkey.operation == '+'){
+                    new_val = (arg1%supermod) + (arg2%supermod);
+                }else{
+                    new_val = (arg1%supermod) * (arg2%supermod);
+                }
+
+                //Only in part 1, the worry level decreases
+                if constexpr(Part == 1){
+                    new_val = new_val/3;
+                }                
+
+                //Add this item to the proper monkey's inventory
+                if(new_val % monkey.divisible_by == 0){
+                    monkeys[monkey.monkey_if_true ].items.push_back(new_val % supermod);
+                }else{
+                    monkeys[monkey.monkey_if_false].items.push_back(new_val % supermod);
+                } 
+
+                //Increase the monkey activity
+                monkey.activity++;               
+            }
+            //Clear this monkey's inventory (all items have been transferred)
+            monkey.items.clear();
+        }
+    }
+
+    //Print the activity and currently held items for each monkey
+    std::vector<long> activities;
+    for(Monkey& monkey: monkeys){
+        activities.push_back(monkey.activity);
+        out << "monkey " << monkey.id << " has activity " << monkey.activity << " and holds: ";
+        for(long item: monkey.items){
+            out << item << ", ";
+        }
+        out << std::endl;
+    }
+    
+    //Calculate the Monkey business score
+    std::sort(activities.begin(), activities.end(),std::greater<long>());
+    out << "monkey activity score " << activities[0]*activities[1] << std::endl;
+}
+
+//Monkey business
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    std::vector<Monkey> monkeys;
+    Monkey monkey;
+
+    //"super modulo": use this to keep the worry levels under control in part 2
+    int supermod = 1;
+    //Every monkey is described by a block of lines
+    std::string_view block;
+    while(input.get_block(block)){
+        aoc::Scanner scanner(block);
+
+        //Monkey \d --> monkey ID
+        scanner.expect("Monkey ");
+        monkey.id = scanner.next_int<unsigned>();
+        scanner.expect(":\n");
+
+        //starting items
+        scanner.expect("  Starting items: ");
+        monkey.items.clear();
+        while(scanner.peek() != '\n'){
+            monkey.items.push_back(scanner.next_int<unsigned>());
+            if(scanner.peek() == ','){
+                scanner.expect(", ");
+            }
+        }
+
+        //Operation
+        scanner.expect("\n  Operation: new = old ");
+        monkey.operation = scanner.next_char();
+        monkey.arg1      = -1;
+        scanner.expect(" ");
+        if(scanner.starts_with("old")){
+            monkey.arg2 = -1;
+            scanner.expect("old");
+        }else{
+            monkey.arg2 = scanner.next_int<unsigned>();
+        }
+
+        //Test. Only checks if divisible by
+        scanner.expect("\n  Test: divisible by ");
+        monkey.divisible_by    = scanner.next_int<unsigned>();
+        supermod *= monkey.divisible_by;
+
+        //Throw to monkey X if true
+        scanner.expect("\n    If true: throw to monkey ");
+        monkey.monkey_if_true  = scanner.next_int<unsigned>();
+
+        //Throw to monkey Y if false. 
+        scanner.expect("\n    If false: throw to monkey ");
+        monkey.monkey_if_false = scanner.next_int<unsigned>();
+
+        //We are done with this monkey
+        monkeys.push_back(monkey);
+    }
+
+    timer.phase("parse");
+    
+    aoc::for_each_part(part,[&](auto p){
+        monkey_business<decltype(p)::value>(monkeys,supermod,out);
+    });
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+#include <ostream>
+#include "aoc_utility.hpp"
+
+//Monkey in the Middle
+namespace puzzle11{
+    //Solve the given part (1, 2, or aoc::all_parts for both) of the puzzle
+    //for the given input, and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "puzzle12.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "aoc_utility.hpp"
+#include "aoc_grid.hpp"
+#include "aoc_search.hpp"
+
+namespace puzzle12{
+
+//Map type: the height of every position (0 to 25)
+using map_type = aoc::Grid<char>;
+
+//Height of the border around the map. It is too high to ever climb onto,
+//so the search never leaves the map.
+constexpr char border_height = 127;
+
+//Current heuristic: Manhattan distance.
+//Problem specific
+int heuristic(const map_type& map, int node, const map_type::coord_type& target){
+    auto pos = map.coords(node);
+    return std::abs(pos[0] - target[0]) + std::abs(pos[1] - target[1]);
+}
+
+//Hill Climbing Algorithm
+//Part 1 is the shortest route from the start to the end, part 2 the shortest
+//route from any lowest position to the end
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //Read in the height map
+    map_type height_map = map_type::from_text(input.data(),1,border_height);
+
+    //Start end and position
+    int startnode = -1;
+    int endnode   = -1;
+
+    //Convert height map to ints
+    height_map.for_each_cell([&](auto index){
+        char c = height_map[index];
+        if(c >= 'a' && c <= 'z'){
+            height_map[index] = c - 'a';
+        }else if(c == 'S'){
+            height_map[index] = 0;
+            startnode = index;
+        }else if(c == 'E'){
+            height_map[index] = 25;
+            endnode = index;
+        }else{
+            throw std::runtime_error("invalid char encountered");
+        }
+    });
+    if(startnode < 0 || endnode < 0){
+        throw std::runtime_error("start or end position missing");
+    }
+
+    timer.phase("parse");
+
+    //You can move to a neighbor that is at most 1 higher
+    const auto offsets = height_map.neighbour_offsets();
+    const int n_nodes  = static_cast<int>(height_map.storage_size());
+
+    for(int p : aoc::parts(part)){
+        if(p == 1){
+            //Part 1: A* search from the start to the end
+            auto neighbours = [&](int node, auto&& visit){
+                AOC_COUNT("nodes_expanded");
+                for(auto offset : offsets){
+                    if(height_map[node + offset] - height_map[node] <= 1){
+                        visit(node + offset,1);
+                    }
+                }
+            };
+            AOC_SCOPE("A_Star");
+            const auto endpos = height_map.coords(endnode);
+            auto result = aoc::search::astar(n_nodes,{startnode},neighbours,
+                [&](int node){ return heuristic(height_map,node,endpos); },
+                [&](int node){ return node == endnode; }
+            );
+            if(!result.found()){
+                throw std::runtime_error("A* failed to find a route");
+            }
+            out << "route took " << result.distance[endnode] << " steps" << std::endl;
+        }else{
+            //Part 2: reverse the search. Walk down from the end (at most 1
+            //lower per step), until the first position at height 0. The
+            //border is never entered, since it is higher than any position.
+            auto neighbours = [&](int node, auto&& visit){
+                AOC_COUNT("nodes_expanded");
+                for(auto offset : offsets){
+                    if(height_map[node] - height_map[node + offset] <= 1 && height_map[node + offset] != border_height){
+                        visit(node + offset);
+                    }
+                }
+            };
+            AOC_SCOPE("BFS");
+            auto result = aoc::search::bfs(n_nodes,{endnode},neighbours,
+                [&](int node){ return height_map[node] == 0; }
+            );
+            if(!result.found()){
+                throw std::runtime_error("BFS failed to find a route");
+            }
+            out << "route took " << result.distance[result.goal] << " steps" << std::endl;
+        }
+    }
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include <variant>
+#include <memory_resource>
+#include "aoc_utility.hpp"
+
+//Distress Signal
+namespace puzzle13{
+    //Solve the puzzle for the given input (both parts are always solved, the
+    //part number is ignored), and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Kernels of the solver (also measured by aoc_microbench)
+
+    //The lists of a packet are allocated from the arena of the solve. Lists are
+    //only ever moved (which keeps the arena), never copied.
+    struct List{
+        explicit List(std::pmr::memory_resource* arena) : nodes(arena){}
+
+        //Each list element is either a number, or a list
+        std::pmr::vector<std::variant<int,List>> nodes;
+    };
+    using list_or_num = std::variant<int,List>;
+
+    //Parse a packet (without its outer brackets) into node
+    void parse(List* node, std::string_view in);
+
+    //Compare two packets.
+    //Return -1 if wrong order, 0 if unknown (so proceed), 1 if right order
+    int sorted(const list_or_num& node_a, const list_or_num& node_b);
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "puzzle14.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include "aoc_utility.hpp"
+#include "aoc_grid.hpp"
+
+namespace puzzle14{
+
+// The map is stored as [row,col] = [y,x - x_offset], where y = 0 represents
+// the top of the map. Sand falls towards higher rows.
+using map_type   = aoc::Grid<char>;
+using index_type = map_type::index_type;
+using pos_type   = std::array<int,2>;
+
+
+//Move a grain of sand 1 step down.
+//Returns true if the sand could move, false if it could not move
+//Note: the bottom row of the map is a floor, so the sand never leaves the map
+bool move_sand(const map_type& map, index_type& sand_pos){
+    AOC_COUNT("sand_moves");
+    
+    const index_type down = map.stride(0);
+
+    //Attempt to fall straight down
+    if(map[sand_pos + down] == '.'){
+        //Free space --> fall        
+        sand_pos += down;
+        return true;      
+    }
+
+    //Attempt to fall diagonally to the left
+    if(map[sand_pos + down - 1] == '.'){
+        //Free space --> fall        
+        sand_pos += down - 1;
+        return true;   
+    }
+
+    //Attempt to fall diagonally to the right
+    if(map[sand_pos + down + 1] == '.'){
+        //Free space --> fall        
+        sand_pos += down + 1;
+        return true;   
+    }
+
+    //Sand can't fall anymore -> we are done
+    return false;
+}
+
+//Draw the map (lower_left and upper_right are in map coordinates [x,y])
+void draw_map(std::ostream& out, const map_type& map,const pos_type& lower_left,const pos_type& upper_right){    
+    for(int y = lower_left[1]; y<upper_right[1]+1; y++){    
+        for(int x = lower_left[0]; x<upper_right[0]+1; x++){    
+            out << map(y,x);
+        }
+        out << std::endl; 
+    }       
+}
+
+//Drop sand until it falls into the abyss (part 1), or until it reaches the
+//source (part 2). The map is passed by value, since every part starts from
+//the empty map. lower_left and upper_right are the draw limits of the rocks.
+template<int Part>
+void drop_sand(map_type map, index_type start_pos, pos_type lower_left, pos_type upper_right, std::ostream& out){
+    //The lowest rock
+    const int rocks_bottom = upper_right[1];
+
+    if constexpr(Part == 2){
+        //Increase the draw boundaries to include (part of) the shelf
+        upper_right[1] += 3;
+        upper_right[0] += 3;
+        lower_left[0]  -= 3;
+    }
+
+    //Draw the map
+    out << "Initial map:" << std::endl;    
+    draw_map(out,map,lower_left,upper_right);
+
+    //Drop sand
+    AOC_SCOPE("drop_sand");
+    //Both parts always end: in part 1 the sand finds a way past the rocks
+    //(or the rocks hold it, and it reaches the source), in part 2 the floor
+    //holds it
+    for(int i = 0; ; i++){
+        AOC_COUNT("sand_grains");
+        index_type sand_pos = start_pos;
+        while(move_sand(map,sand_pos)){
+           //std::cout << sand_pos << std::endl;
+        }
+        map[sand_pos] = 'o';
+
+        auto sand_coords = map.coords(sand_pos);
+
+        //For part 2, adjust the plot boundaries, to make sure all the 
+        //sand fits in the picture
+        if constexpr(Part == 2){
+            lower_left[0]   = std::min(sand_coords[1],lower_left[0]);
+            upper_right[0]  = std::max(sand_coords[1],upper_right[0]);
+        }
+        
+        if(Part == 1 && sand_coords[0] > rocks_bottom){   
+            //End condition for part 1 reached (sand is flowing out of the map)
+            map[sand_pos] = '.';
+            sand_pos = start_pos;        
+            //Add the final trail of sand for fun
+            while(move_sand(map,sand_pos)){
+                map[sand_pos] = '~';                
+            }
+            out << "Final map:" << std::endl;
+            draw_map(out,map,lower_left,upper_right);
+            out << "Sand starts falling into the abbyss after " << i << " grains of sand" << std::endl;
+            break;
+        }else if(sand_pos == start_pos){
+            //End condition for part 2 reached (sand reached source)
+            out << "Final map:" << std::endl;
+            draw_map(out,map,lower_left,upper_right);
+            out << "Sand stopped falling (reached source) after " << i+1 << " grains of sand" << std::endl;
+            break;
+        }
+    }
+}
+
+//Regolith Reservoir
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    
+    std::string_view line;
+
+    //The position of the "sand spawn"
+    const pos_type source{500,0};
+
+    //Read in the rock paths (x1,y1,x2,y2 per segment), and determine the
+    //extent of the rocks
+    std::vector<std::array<int,4>> segments;
+    pos_type rocks_min = source;
+    pos_type rocks_max = source;
+    while(input.getline(line)){
+        bool do_draw = false;
+        std::array<int,2> prev;
+        //Lines look like: x1,y1 -> x2,y2 -> x3,y3
+        aoc::Scanner scanner(line);
+        while(1){
+
+            //Each segment is split on ','
+            int x = scanner.next_int<unsigned>();
+            scanner.expect(",");
+            int y = scanner.next_int<unsigned>();
+
+            if(do_draw){
+                segments.push_back({prev[0],prev[1],x,y});
+            }
+            prev[0] = x;
+            prev[1] = y;
+            do_draw = true;
+
+            //Establish the limits of the map
+            rocks_max[0] = std::max(x,rocks_max[0]);
+            rocks_max[1] = std::max(y,rocks_max[1]);
+            rocks_min[0] = std::min(x,rocks_min[0]);
+            rocks_min[1] = std::min(y,rocks_min[1]);
+
+            //End of the line -> last coordinate pair of this line is drawn
+            if(scanner.done()){
+                break;
+            }
+            scanner.expect(" -> ");
+        }
+    }
+
+    //Size the map to the input. The floor (part 2) is 2 below the lowest rock,
+    //and the sand piles up in a triangle from the source to the floor, so
+    //it never goes further than floor_y to the left or right of the source.
+    //The border leaves some room around the picture.
+    const int floor_y  = rocks_max[1] + 2;
+    const int x_offset = std::min(rocks_min[0],source[0] - floor_y);
+    const int x_max    = std::max(rocks_max[0],source[0] + floor_y);
+    const int border   = 3;
+    map_type map({floor_y + 1,x_max - x_offset + 1},border,'.','.');
+    for(const auto& segment : segments){
+        //Draw a line (technically speaking a block)
+        for(int x = std::min(segment[0],segment[2]); x!=std::max(segment[0],segment[2])+1; x++){
+            for(int y = std::min(segment[1],segment[3]); y!=std::max(segment[1],segment[3])+1; y++){
+                map(y,x - x_offset) = '#';
+            }
+        }
+    }
+
+    //Add a "shelf" below the map. For part 1, this only keeps the sand in
+    //the map: the first grain that gets below the rocks falls into the abyss.
+    for(int x = 0; x<map.cols(); x++){
+        map(floor_y,x) = '#';
+    }
+
+    //Add the "sand dropper"
+    const index_type start_pos = map.index(source[1],source[0] - x_offset);
+    map[start_pos] = '+';
+
+    timer.phase("parse");
+
+    //The draw limits of the map, in map coordinates
+    pos_type lower_left  = {rocks_min[0] - x_offset,rocks_min[1]};
+    pos_type upper_right = {rocks_max[0] - x_offset,rocks_max[1]};
+
+    aoc::for_each_part(part,[&](auto p){
+        drop_sand<decltype(p)::value>(map,start_pos,lower_left,upper_right,out);
+    });
+    
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "puzzle15.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "aoc_pattern.hpp"
+#include <limits>
+#include "aoc_utility.hpp"
+#include "aoc_tasks.hpp"
+#include <mutex>
+#include <sstream>
+#include <optional>
+#include "aoc_interval.hpp"
+
+namespace puzzle15{
+
+struct point{
+    int x = 0;
+    int y = 0;
+};
+
+int manhattan_distance(const point& a, const point& b){
+    return std::abs(a.x-b.x) + std::abs(a.y-b.y);
+}
+
+//Scan the rows of the search box for positions that are not covered by any
+//sensor: a single row for part 1, all rows of the box for part 2
+template<int Part>
+void scan_rows(const std::vector<point>& sensors, const std::vector<int>& radius, const std::vector<point>& beacons, std::ostream& out){
+    //Establish the boundaries of the "search box"
+    constexpr int min_row = (Part == 1) ? 2000000 : 0;
+    constexpr int max_row = (Part == 1) ? 2000001 : 4000000;
+    constexpr int min_col = (Part == 2) ? min_row : std::numeric_limits<int>::min();
+    constexpr int max_col = (Part == 2) ? max_row : std::numeric_limits<int>::max();
+
+    //The rows are independent, so they are scanned in parallel (in blocks of
+    //rows). The results are collected, and printed in order afterwards.
+    std::mutex results_mutex;
+    std::vector<std::pair<int,std::string>> results;
+    const int block_size = 4096;
+    const int n_blocks   = (max_row - min_row + block_size - 1) / block_size;
+    aoc::parallel_for(0,n_blocks,1,[&](int block){
+        //The covered ranges of a row. The set is reused for all rows of the
+        //block, so it only allocates for the first row.
+        aoc::IntervalSet<int> ranges;
+        ranges.reserve(sensors.size());
+
+        const int block_end = std::min(max_row,min_row + (block+1)*block_size);
+        for(int row = min_row + block*block_size; row<block_end; row++){
+            ranges.clear();
+            for(int i = 0; i<sensors.size(); i++){
+                //Vertical projection of a sensor on the desired row
+                point projection;
+                projection.x = sensors[i].x;
+                projection.y = row;
+
+                //Check if this projection is in range of the sensor
+                int dx = radius[i] - manhattan_distance(projection,sensors[i]);
+                if(dx < 0){
+                    continue;
+                }
+                ranges.add(std::max(min_col,projection.x-dx),std::min(max_col,projection.x+dx));
+            }
+
+            //Sort the ranges, and merge the ones that overlap / are adjacent
+            ranges.merge();
+
+            std::string result;
+            if constexpr(Part == 1){
+                //Covered positions, except for the beacons that are on this row
+                long long n_blocked = ranges.covered();
+                std::vector<int> beacons_on_row;
+                for(const auto& beacon : beacons){
+                    if(beacon.y == row && ranges.contains(beacon.x)){
+                        beacons_on_row.push_back(beacon.x);
+                    }
+                }
+                std::sort(beacons_on_row.begin(),beacons_on_row.end());
+                n_blocked -= std::unique(beacons_on_row.begin(),beacons_on_row.end()) - beacons_on_row.begin();
+                std::ostringstream line;
+                line << "blocked positions on line "<< row << " (= part 1 answer) : " << n_blocked << std::endl;
+                result = line.str();
+            }else{
+                //Only the row with a gap is reported
+                std::optional<int> col = ranges.first_gap(min_col,max_col);
+                if(!col){
+                    continue;
+                }
+                //longs are needed, because te values overflow otherwise
+                std::ostringstream line;
+                line << "Beacon is on (" << row << ","<< *col << "). Part 2 answer: " 
+                     << (long(*col)*long(4000000)+long(row)) << std::endl;
+                result = line.str();
+            }
+            std::lock_guard<std::mutex> lock(results_mutex);
+            results.emplace_back(row,result);
+        }
+    });
+
+    std::sort(results.begin(),results.end());
+    for(const auto& result : results){
+        out << result.second;
+    }
+}
+
+//Beacon Exclusion Zone
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    
+    std::string_view line;
+
+    //INput is provided in this form
+    static constexpr char line_pattern[] = "Sensor at x={i}, y={i}: closest beacon is at x={i}, y={i}";
+
+    std::vector<point> sensors; // Sensor positions
+    std::vector<point> beacons; // Beacon closest to sensor
+    std::vector<int>   radius;  // Radius around sensor containing no other beacon
+    
+    //Read in the data
+    while(input.getline(line)){
+        //Parse input line
+        point beacon;
+        point sensor;
+        if(!aoc::Pattern<line_pattern>::match(line,sensor.x,sensor.y,beacon.x,beacon.y)){
+            throw std::runtime_error("Pattern match failed while parsing input!");
+        }
+
+        //Store the sensor and beacon positions
+        beacons.push_back(beacon);
+        sensors.push_back(sensor);
+        radius.push_back(manhattan_distance(sensor,beacon));
+    }
+
+    timer.phase("parse");
+
+    aoc::for_each_part(part,[&](auto p){
+        scan_rows<decltype(p)::value>(sensors,radius,beacons,out);
+    });
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
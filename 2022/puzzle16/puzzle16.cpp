@@ -0,0 +1,242 @@
+#include "puzzle16.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "aoc_pattern.hpp"
+#include <unordered_map>
+#include "aoc_utility.hpp"
+#include "aoc_tasks.hpp"
+#include "aoc_search.hpp"
+#include "aoc_arena.hpp"
+#include <cmath>
+
+namespace puzzle16{
+
+//A valve/chamber as read in from input file.
+struct Valve{
+    std::string id;
+    int flowrate;
+    std::vector<std::string> connections;
+};
+using valve_list  = std::unordered_map<std::string,Valve>;
+
+//A more efficient representation of the valve.
+//Furthermore, this representation only stores the 
+//connections to "functional" valves, and id's are used instead of strings
+//This combined cuts the runtime by about a factor 5
+//The distances are a row of the distance matrix, which lives in an arena:
+//copies of the valve list share it.
+struct CompactValve{
+    std::string name;
+    int id;
+    int flowrate;
+    const int* distances = nullptr;
+    bool opened  = false;
+    bool visited = false;
+};
+using compact_valve_list = std::vector<CompactValve>;
+
+//Pressure released by all currently opened valves
+int pressure_released_per_minute(const compact_valve_list& valves){
+    int pressure_diff = 0;
+    for(const auto& valve: valves){
+        if(valve.opened){
+            pressure_diff += valve.flowrate;
+        }
+    }
+    return pressure_diff;
+}
+
+//Find the shortest distance from one valve to all other valves
+//(every tunnel takes one minute). tunnels holds the connections of every
+//valve by number.
+std::vector<int> dist_to_valves(const std::vector<std::vector<int>>& tunnels, int start){
+    auto result = aoc::search::bfs(tunnels.size(),{start},[&](int node, auto&& visit){
+        for(int neighbor : tunnels[node]){
+            visit(neighbor);
+        }
+    });
+    return result.distance;
+}
+
+//Find the optimal amount of pressure relieved when only working yourself
+// valves:  valve list
+// minutes: minutes remaining
+// current: node we find ourselves at currently
+//This function has (I think) a complexity of N!, with N the number of 
+//valves that have non-zero flowrate. So this could take a while...
+int pressure_released(compact_valve_list& valves, const int minutes, int current){
+    AOC_SCOPE("pressure_released");
+    
+    //Pressure released this minute due to all currently opened valves
+    int pressure_decrease_per_min = pressure_released_per_minute(valves);
+
+    //The pressure released were we to do nothing
+    int max_pressure_released = minutes*pressure_decrease_per_min;
+    //Go to one of the unopened valves
+    for(const auto& new_target : valves){
+        //Go to a NEW valve
+        if(new_target.id == current){
+            continue;
+        }
+        //Only valves with a nonzero flowrate are interesting to consider
+        if(new_target.opened || new_target.flowrate == 0){
+           continue;
+        }
+        //Only consider valves that we can actually reach in time
+        int distance = valves[current].distances[new_target.id];
+        int minutes_remaining  = minutes-distance-1; 
+        if(minutes_remaining < 0){
+            continue;
+        }
+
+        //Select a new target and start walking
+        AOC_COUNT("paths_expanded");
+        valves[new_target.id].opened = true;
+        int target_decrease   = pressure_released(valves,minutes_remaining,new_target.id) + (distance+1)*pressure_decrease_per_min;
+        valves[new_target.id].opened = false;
+
+        max_pressure_released = std::max(target_decrease,max_pressure_released);        
+    }
+    return max_pressure_released;    
+}
+
+//Proboscidea Volcanium
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    
+    std::string_view line;
+
+    //INput is provided in this form
+    //(the words "tunnel(s) lead(s) to valve(s)" are skipped)
+    static constexpr char line_pattern[] = "Valve {w} has flow rate={u}; {_} {_} to {_} {s}";
+
+    valve_list  valves;
+    Valve valve;
+
+    //Read in the data
+    while(input.getline(line)){
+        //Parse input line
+        //Valve identifier, this valve's flowrate and the connected chambers
+        std::string_view connections;
+        if(!aoc::Pattern<line_pattern>::match(line,valve.id,valve.flowrate,connections)){
+            throw std::runtime_error("Pattern match failed while parsing input!");
+        }
+
+        //Get connected chambers
+        valve.connections.clear();
+        while(!connections.empty()){
+            std::string_view connection = aoc::next_field(connections,',');
+            if(connection[0] == ' '){
+                connection.remove_prefix(1);
+            }
+            valve.connections.emplace_back(connection);
+        }
+        valves[valve.id] = valve;
+    }
+
+    timer.phase("parse");
+
+    //We start both parts at this valve
+    std::string start = "AA";   
+    int start_id;
+
+    //Create a subgraph, containing only the functional valves
+    compact_valve_list compact_valves;
+    CompactValve compact_valve;  
+    int counter = 0;  
+    for(auto& valve : valves){
+        if(valve.first == start || valve.second.flowrate > 0){
+            if(valve.first == start){
+                start_id = counter;
+            }
+            compact_valve.id        = counter;
+            compact_valve.name      = valve.first;
+            compact_valve.flowrate  = valve.second.flowrate;
+            compact_valves.push_back(compact_valve);
+            counter++;
+        }        
+    }
+
+    //Number all valves, and store the tunnels by number
+    std::unordered_map<std::string,int> ids;
+    for(const auto& valve : valves){
+        ids.emplace(valve.first,ids.size());
+    }
+    std::vector<std::vector<int>> tunnels(ids.size());
+    for(const auto& valve : valves){
+        for(const auto& connection : valve.second.connections){
+            tunnels[ids.at(valve.first)].push_back(ids.at(connection));
+        }
+    }
+
+    //Pre-calculate the shortest distance from each valve to each other valve
+    //(one breadth-first search per functional valve). The rows of the matrix
+    //are allocated one after the other, so the matrix is contiguous.
+    aoc::Arena arena;
+    for(auto& start_valve : compact_valves){
+        std::vector<int> distances = dist_to_valves(tunnels,ids.at(start_valve.name));
+        int* row = arena.allocate_array<int>(compact_valves.size());
+        for(auto& target_valve : compact_valves){
+            int distance = distances[ids.at(target_valve.name)];
+            if(distance == aoc::search::unreachable){
+                throw std::runtime_error("Could not find path between nodes " + start_valve.name + " and " + target_valve.name);
+            }
+            row[target_valve.id] = distance;
+        }
+        start_valve.distances = row;
+    }   
+
+    //Okay, now let's do this..    
+    if(valves[start].flowrate > 0){
+        throw std::runtime_error("Current algorithm assumes that the flowrate of the start node is 0");
+    }
+
+    //Both parts use the same distances between the valves
+    for(int p : aoc::parts(part)){
+        if(p == 1){
+            //Part 1 is a simple breadth-first search of the graph      
+            out << "Total pressure released: " << pressure_released(compact_valves,30,start_id) << std::endl;
+        }else{
+            //Brute force solution to part 2 (takes 2-3 minutes)
+            //Split the valves-to-be-opened in two subsets: one for you, one for the elephant.
+            //See which distribution (and there are ~2^15 of them..) works best.
+            //I am sure this can be done in a smarter way.
+            //The distributions are divided over the task pool in blocks. Every block
+            //has its own copy of the valves, since pressure_released modifies them.
+            const int n_distributions = std::pow(2,compact_valves.size());
+            const int block_size = 64;
+            const int n_blocks = (n_distributions + block_size - 1)/block_size;
+            auto block_score = [&](int block){
+                int max_score = 0;
+                compact_valve_list you = compact_valves;
+                compact_valve_list ele = compact_valves;
+                for(int i = block*block_size; i<std::min(n_distributions,(block+1)*block_size); i++){
+                    int j = 0;
+                    for(const auto& valve : compact_valves){
+                        if(i & (1<<j)){
+                            you[valve.id].flowrate = 0;
+                            ele[valve.id].flowrate = valve.flowrate;
+                        }else{
+                            ele[valve.id].flowrate = 0;
+                            you[valve.id].flowrate = valve.flowrate;
+                        }
+                        j++;                
+                    }
+                    int score_you = pressure_released(you,26,start_id);
+                    int score_ele = pressure_released(ele,26,start_id);
+                    max_score     = std::max(max_score, score_you + score_ele);
+                }
+                return max_score;
+            };
+            int max_score = aoc::parallel_reduce(0,n_blocks,1,0,block_score,[](int a, int b){ return std::max(a,b); });
+            out << "Total pressure released: " << max_score << std::endl;
+        }
+    }
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "puzzle17.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include "aoc_utility.hpp"
+#include "aoc_cycle.hpp"
+
+namespace puzzle17{
+
+//Define the shapes
+std::array<Shape,N_shapes> make_shapes(){
+    std::array<Shape,N_shapes> shapes;
+
+    //The "horizontal dash"
+    shapes[0].rows   = 1;
+    shapes[0].cols   = 4;
+    shapes[0].blocks = {1,1,1,1};
+    
+    //The "cross"
+    shapes[1].rows   = 3;
+    shapes[1].cols   = 3;
+    shapes[1].blocks = {0,1,0,1,1,1,0,1,0};
+
+    //The "left L"
+    shapes[2].rows   = 3;
+    shapes[2].cols   = 3;
+    shapes[2].blocks = {1,1,1,0,0,1,0,0,1};
+
+    //The "vertical line"
+    shapes[3].rows   = 4;
+    shapes[3].cols   = 1;
+    shapes[3].blocks = {1,1,1,1};
+
+    //The "square"
+    shapes[4].rows   = 2;
+    shapes[4].cols   = 2;
+    shapes[4].blocks = {1,1,1,1};
+
+    return shapes;
+}
+
+//Detect of this block currently collides with the map
+//Pos is the left lower corner of the shape!
+bool detect_collision(const Map& map, const Shape& shape, const pos_type& pos){
+    AOC_COUNT("collision_checks");
+    //Shape collided with bottom of the map
+    if(pos.second < 0){
+        return true;
+    }
+    //Shape collided with the left edge of the map
+    if(pos.first < 0){
+        return true;
+    }
+    //Shape collided with the right edge of the map
+    if(pos.first > N_cols - shape.cols){
+        return true;
+    }
+    //Check if shape collided with another piece in the map
+    for(int i = 0; i<shape.blocks.size(); i++){
+        if(!shape.blocks[i]){
+            continue;
+        } 
+        int row = pos.second + (i / shape.cols);
+        int col = pos.first  + (i % shape.cols);                 
+        if(map.blocks[row][N_cols-col-1]){
+            return true;
+        }
+    }
+    return false;
+}
+
+//Write a shape to the matrix once it reached its final destination
+void write_shape(Map& map, const Shape& shape, const pos_type& pos){
+    for(int i = 0; i<shape.blocks.size(); i++){
+        if(!shape.blocks[i]){
+            continue;
+        }
+        int row = pos.second + (i / shape.cols);
+        int col = pos.first  + (i % shape.cols);        
+        map.blocks[row][N_cols-col-1] = true; 
+    }
+}
+
+//Draw the map. Mostly for debug purposes
+//(If you uncomment all print statements in main(), the 
+//output will be similar to the text in the example)
+void draw_map(std::ostream& out, const Map& map){
+    for(size_t row = map.blocks.size(); row!=0; --row){
+        out << "|";
+        for(int col = 0; col<N_cols; col++){
+            if(map.blocks[row-1][N_cols-col-1]){
+                out << "#";
+            }else{
+                out << " ";
+            }
+        }
+        out << "|" << std::endl;
+    }
+    out << "+-------+" << std::endl;
+}
+
+//The state that is used to find a repeating section:
+// - shape index
+// - wind direction
+// - top rows of the board
+//20 rows might not be strictly enough to cover all cases. Raising this number
+//will increase how sure the match is, but impacts runtime. If you get
+//incorrect answers, increase this number
+const int search_repeat = 20;
+struct State{
+    int shape;
+    int direction;
+    std::array<uint8_t,search_repeat> rows;
+};
+
+//The state after a rock came to rest. Rows below the floor are empty (which
+//never happens above the floor, so these states are unique).
+State game_state(const Map& map, int shape, int direction, int height){
+    State state{shape,direction,{}};
+    for(int r = 0; r<search_repeat && r<height; r++){
+        state.rows[r] = map.blocks[height-1-r].to_ulong();
+    }
+    return state;
+}
+
+//Pyroclastic Flow
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //Obtain the single line of input (wind directions)
+    std::string_view line;
+    input.getline(line);
+
+    timer.phase("parse");
+    std::size_t N_directions = line.length();
+
+    //Define the shapes
+    const std::array<Shape,N_shapes> shapes = make_shapes();
+
+    //Map that holds the "board".
+    Map map;
+
+    //For part 2: find the repeating section, and the height it adds
+    aoc::CycleDetector<State> cycle;
+
+    //Start dropping shapes   
+    int current_height = 0;                 //Current maximum height achieved
+    pos_type      pos{2,current_height+3};  //Position of piece while dropping
+    pos_type prev_pos{2,current_height+3};  //Position of piece during previous time step
+    int direction_counter = 0;              //Wind direction index
+
+    int rock;
+    AOC_SCOPE("drop_rocks");
+    for(rock = 0; rock<10000; rock++){
+        AOC_COUNT("rocks");
+
+        //std::cout << "Rock " << rock+1 << " begins falling. (" << pos.first << ","<< pos.second << ")" << std::endl;
+
+        //Make sure the map is large enough to receive our piece
+        while(map.blocks.size() < current_height + 10){
+            map.blocks.push_back(0);
+        }
+        
+        //Block index cycles through the shapes in a fixed order
+        int block_index = rock%N_shapes;
+        
+        while(1){
+            //Move to the left or to the right
+            char direction = line[direction_counter % N_directions];
+            direction_counter = (direction_counter+1)%N_directions;
+            if(direction == '>'){
+                pos.first += 1;
+                //std::cout << "Jet of gas pushes rock right (" << pos.first << ","<< pos.second << "):" ;                              
+            }else{ 
+                pos.first -= 1;
+                //std::cout << "Jet of gas pushes rock left(" << pos.first << ","<< pos.second << "):";
+            }
+
+            //Check if the jet push was legal
+            if(detect_collision(map,shapes[block_index],pos)){
+                //Reject move
+                pos = prev_pos;                
+                //std::cout << ", but nothing happens." << std::endl;   
+            }else{
+                //Accept move
+                prev_pos = pos;
+                //std::cout << std::endl;             
+            }
+
+            //Try to move the block down
+            pos.second -= 1;
+
+            //Check if moving down was legal
+            if(detect_collision(map,shapes[block_index],pos)){
+                //Rock got stuck
+                //std::cout << "Rock falls 1 unit, causing it to come to rest" << std::endl;
+                //std::cout << pos.first << "," << pos.second << std::endl;
+                write_shape(map,shapes[block_index],prev_pos);
+                break;
+            }else{
+                //Accept move
+                //std::cout << "Rock falls one unit(" << pos.first << ","<< pos.second << ")" << std::endl;               
+                prev_pos = pos;
+            }                    
+        }
+
+        //Store current stack height (the top of the rock, if that is higher)
+        current_height = std::max<int>(current_height,prev_pos.second + shapes[block_index].rows);
+
+        //Check if this game state was seen before
+        if(cycle.add(game_state(map,block_index,direction_counter,current_height),current_height)){
+            out << "Sequence repeats after " << rock << " rocks!" << std::endl;
+            break;
+        }
+
+        //Reset the shape, prepare for dropping a new one
+        pos.first = 2;
+        pos.second = current_height + 3;
+        //std::cout << "Map after rock has come to stand still:: " << std::endl;
+        //draw_map(out,map);
+        //std::cout << "current highest block: " << current_height << std::endl;
+        
+    }
+
+    //We can at least answer part 1, but part 2 can only run if a repeating section is found
+    if(!cycle.found()){
+        out << "Tower after 2022 blocks is " << cycle.value_at(2021) << " blocks tall" << std::endl;
+        throw std::runtime_error("No repeating section was found!!");
+    }
+
+    //The height after N rocks is the height after rock N-1, extrapolated
+    //from the repeating section
+    out << "Tower after 2022 blocks is " << cycle.value_at(2022-1) << " blocks tall" << std::endl;
+    out << "Tower after 1000000000000 blocks is " << cycle.value_at(1000000000000-1) << " blocks tall" << std::endl;
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
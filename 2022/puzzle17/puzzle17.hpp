@@ -0,0 +1,39 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include <array>
+#include <bitset>
+#include <utility>
+#include "aoc_utility.hpp"
+
+//Pyroclastic Flow
+namespace puzzle17{
+    //Solve the puzzle for the given input (both parts are always solved, the
+    //part number is ignored), and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Kernels of the solver (also measured by aoc_microbench)
+
+    //The map is a matrix with dimensions Nx7
+    //Matrix dimensions grow as needed.
+    const int N_cols   = 7;
+    using pos_type = std::pair<long long,long long>;
+    struct Map{
+        std::vector<std::bitset<N_cols>> blocks;
+    };
+
+    //General structure that holds a shape
+    struct Shape{
+        int rows = 0;
+        int cols = 0;
+        std::vector<bool> blocks;
+    };
+
+    //The five shapes, in the order in which they fall
+    const int N_shapes = 5;
+    std::array<Shape,N_shapes> make_shapes();
+
+    //Detect of this block currently collides with the map
+    //Pos is the left lower corner of the shape!
+    bool detect_collision(const Map& map, const Shape& shape, const pos_type& pos);
+}
\ No newline at end of file
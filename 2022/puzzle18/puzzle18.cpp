@@ -0,0 +1,95 @@
+#include "puzzle18.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include "aoc_utility.hpp"
+#include "aoc_pattern.hpp"
+#include "aoc_grid.hpp"
+
+namespace puzzle18{
+
+//Boiling Boulders
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    
+    std::string_view line;
+
+    //Cell types on the map
+    enum : char{ air, lava, steam, wall };
+
+    //Input follows pattern: xx,yy,zz
+    static constexpr char line_pattern[] = "{u},{u},{u}";
+
+    //Read in the cubes, and determine the size of the map
+    std::vector<std::array<int,3>> cubes;
+    std::array<int,3> extent{0,0,0};
+    while(input.getline(line)){
+        int x, y, z;
+        if(!aoc::Pattern<line_pattern>::match(line,x,y,z)){
+            throw std::runtime_error("Pattern match failed while parsing input!");
+        }
+        cubes.push_back({x,y,z});
+        extent[0] = std::max(extent[0],x+1);
+        extent[1] = std::max(extent[1],y+1);
+        extent[2] = std::max(extent[2],z+1);
+    }
+
+    //Store the map in a three dimensional grid. There is a layer of air all
+    //around the droplet (hence the +1 offset and the +2 on the extent), so the
+    //steam can flow all the way around it. The grid border is a wall, which
+    //stops the flood fill without any bounds checks.
+    aoc::Grid<char,3> map({extent[0]+2,extent[1]+2,extent[2]+2},1,air,wall);
+    for(const auto& cube : cubes){
+        map(cube[0]+1,cube[1]+1,cube[2]+1) = lava;
+    }
+    const auto neighbours = map.neighbour_offsets();
+
+    timer.phase("parse");
+
+    //Part 1: count ANY face exposed to air
+    int uncovered = 0;
+    map.for_each_cell([&](auto index){
+        if(map[index] == lava){
+            for(auto offset : neighbours){
+                uncovered += (map[index + offset] != lava);
+            }
+        }
+    });
+    out << "Part 1 - total surface area: " << uncovered << std::endl;
+
+    //Part 2
+    //Only count the surface area on the outside of the shape
+
+    //Do a flood fill from a corner of the map (which is always air)
+    //--> Get every position on the map that can be reached by steam
+    std::vector<aoc::Grid<char,3>::index_type> queue{map.index(0,0,0)};
+    map[queue.front()] = steam;
+    while(!queue.empty()){
+        auto index = queue.back();
+        queue.pop_back();
+        for(auto offset : neighbours){
+            if(map[index + offset] == air){
+                map[index + offset] = steam;
+                queue.push_back(index + offset);
+            }
+        }
+    }
+
+    //Part 2: count only the faces exposed to the outside ("steam")
+    uncovered = 0;
+    map.for_each_cell([&](auto index){
+        if(map[index] == lava){
+            for(auto offset : neighbours){
+                uncovered += (map[index + offset] == steam);
+            }
+        }
+    });
+    out << "Part 2 - outside surface area: " << uncovered << std::endl;
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
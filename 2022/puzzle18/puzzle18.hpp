@@ -0,0 +1,10 @@
+#pragma once
+#include <ostream>
+#include "aoc_utility.hpp"
+
+//Boiling Boulders
+namespace puzzle18{
+    //Solve the puzzle for the given input (both parts are always solved, the
+    //part number is ignored), and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+}
\ No newline at end of file
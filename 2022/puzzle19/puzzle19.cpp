@@ -0,0 +1,248 @@
+#include "puzzle19.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <Eigen/Dense>
+#include "aoc_utility.hpp"
+#include "aoc_pattern.hpp"
+#include "aoc_tasks.hpp"
+
+namespace puzzle19{
+
+enum ResourceType{
+    ore = 0,
+    clay,
+    obsidian,
+    geode
+};
+
+struct Bot{
+    Eigen::Vector4i cost = {0,0,0,0};
+    ResourceType type;
+};
+
+struct Blueprint{
+    int id;
+    Eigen::Vector4i max_cost = {0,0,0,0};
+    std::array<Bot,4> bots;
+};
+
+//Simple function that returns whether we can buy a bot of a certain type, or not.
+bool can_buy(const Blueprint& blueprint, const Eigen::Vector4i& items, ResourceType type){
+    return (items - blueprint.bots[type].cost).minCoeff() >= 0;
+}
+
+//Branches of the search with at least this many minutes left are searched in parallel
+const int parallel_minutes = 20;
+
+//The most minutes any part of the puzzle searches
+const int max_search_minutes = 32;
+
+//Recursive function to calculate the maximum number of geodes mined, within
+//MinutesLeft minutes. The number of minutes is a template parameter, so the
+//decisions that only depend on it (which bots are worth building, whether to
+//search in parallel) are made at compile time.
+template<int MinutesLeft>
+int geodes_collected(const Blueprint& blueprint, Eigen::Vector4i items, Eigen::Vector4i bots);
+
+//geodes_collected<0> ... geodes_collected<max_search_minutes>, to continue the
+//search after waiting for resources (a number of minutes only known at run time)
+using SearchFunction = int(*)(const Blueprint&, Eigen::Vector4i, Eigen::Vector4i);
+template<int... Minutes>
+constexpr std::array<SearchFunction,sizeof...(Minutes)> make_search_table(std::integer_sequence<int,Minutes...>){
+    return {&geodes_collected<Minutes>...};
+}
+constexpr std::array<SearchFunction,max_search_minutes+1> search_table = make_search_table(std::make_integer_sequence<int,max_search_minutes+1>());
+
+template<int MinutesLeft>
+int geodes_collected(const Blueprint& blueprint, Eigen::Vector4i items, Eigen::Vector4i bots){
+    AOC_SCOPE("geodes_collected");
+    constexpr int minutes_left = MinutesLeft;
+
+    //We are done. Return the quality level
+    //(the code below is not reachable then, but it is valid for 0 minutes)
+    if constexpr(minutes_left == 0){
+        return items[geode];
+    }
+
+    //Determine which bots to build, by determining which bots cn actively
+    //Contribute to the final geode count.
+    // - In the last minute, don't build bots at all
+    // - In the one but last minute, only build geode bots
+    // - In the second but last minute, only build geode bots and obsidian bots
+    constexpr std::array<bool,4> build_bots = {
+        minutes_left > 4,   //ore
+        minutes_left > 3,   //clay
+        minutes_left > 2,   //obsidian
+        minutes_left > 1    //geode
+    };
+    
+    //It is (probably?) always smart to buy a geode bot whenever possible.
+    if constexpr(minutes_left > 1){
+        if(can_buy(blueprint,items,geode)){
+            items = items - blueprint.bots[geode].cost + bots;
+            bots[geode]++;
+            return geodes_collected<minutes_left-1>(blueprint,items,bots);
+        }
+    }
+    
+    //Only one robot can be built per minute. The worst score we can get (probably)
+    //is achieved by simply not doing anything at all
+    int max_n_geodes = items[geode] + minutes_left*bots[geode];  
+
+    //Number of geodes collected when building this bot next (-1 if it is not worth it)
+    auto try_bot = [&](ResourceType extra_bot){
+        //Only consider building this bot if sufficient minutes are left
+        if(!build_bots[extra_bot]){
+            return -1;
+        }
+
+        //We can only produce bot N after at least one of bot N-1 has been made
+        //E.g. without a clay bot, we can't make an obsidian bot
+        if(extra_bot > ore && bots[extra_bot-1] == 0){
+            return -1;
+        }
+
+        //Don't spam bots. Only 1 bot can be built per minute. Therefore, it
+        //never makes sense to have more bots of certain resource, than the
+        //maximum amount of resources that can be spent on a single bot
+        if(extra_bot < geode && bots[extra_bot] >= blueprint.max_cost[extra_bot]){
+            return -1;
+        }
+    
+        //Calculate the number of time steps that we need to wait before we can afford this bot.
+        //Only proceed if it makes sense to build (similar to earlier in this function)
+        Eigen::Vector4i new_items = items;
+        int new_minutes_left = minutes_left;
+        int max_minutes = 4 - extra_bot;
+        while(!can_buy(blueprint,new_items,extra_bot) && new_minutes_left>max_minutes){
+            new_items+=bots;
+            new_minutes_left--;
+        }
+
+        int n_geodes;
+        if(new_minutes_left == max_minutes){
+            //Turns out we can not afford this bot in time with our current collection of bots       
+            new_items += max_minutes*bots;     
+            n_geodes = new_items[geode];
+        }else{
+            //We can afford this bot in time, so buy it
+            new_items = new_items - blueprint.bots[extra_bot].cost + bots;
+            Eigen::Vector4i new_bots = bots;
+            new_bots[extra_bot]++;
+            n_geodes = search_table[new_minutes_left-1](blueprint,new_items,new_bots);            
+        }        
+        return n_geodes;
+    };
+
+    if constexpr(minutes_left < parallel_minutes){
+        for(ResourceType extra_bot = ore; extra_bot <= geode; extra_bot = ResourceType(extra_bot+1)){
+            max_n_geodes = std::max(max_n_geodes,try_bot(extra_bot));
+        }
+    }else{
+        //Close to the root of the search tree, the branches are searched in parallel
+        std::array<int,4> n_geodes = {-1,-1,-1,-1};
+        aoc::TaskGroup group;
+        for(ResourceType extra_bot = ore; extra_bot <= geode; extra_bot = ResourceType(extra_bot+1)){
+            group.spawn([&n_geodes,&try_bot,extra_bot](){
+                n_geodes[extra_bot] = try_bot(extra_bot);
+            });
+        }
+        group.sync();
+        max_n_geodes = std::max(max_n_geodes,*std::max_element(n_geodes.begin(),n_geodes.end()));
+    }
+    return max_n_geodes;
+}
+
+//Determine the maximum number of geodes for the blueprints of this part, and
+//print the answer
+template<int Part>
+void evaluate_blueprints(const std::vector<Blueprint>& blueprints, std::ostream& out){
+    //Maximum minutes and the number of blueprints to consider differs between part 1 and 2
+    constexpr int max_minutes = (Part == 1) ? 24 : max_search_minutes;
+    const int n_blueprints    = (Part == 2) ? std::min<size_t>(3,blueprints.size()) : blueprints.size();
+    std::vector<int> geodes(n_blueprints);
+
+    //Solving the blueprints in parallel gives a decent speedup (especially in
+    //debug builds). The search trees differ a lot in size between blueprints,
+    //so every blueprint is a separate task.
+    aoc::parallel_for(0,n_blueprints,1,[&](int i){
+        const Blueprint& blueprint = blueprints[i];
+        //Start out with exactly one ore bot
+        Eigen::Vector4i items = {0,0,0,0};
+        Eigen::Vector4i bots  = {1,0,0,0};
+        geodes[i] = geodes_collected<max_minutes>(blueprint,items,bots);
+    });
+
+    if constexpr(Part == 1){
+        //For part 1, calculate the sum of "quality factors" of all blueprints
+        int quality_sum = 0;
+        for(int i = 0; i<n_blueprints; i++){
+            int quality_score = blueprints[i].id * geodes[i];
+            out << "Blueprint " << blueprints[i].id << " has quality score : " << quality_score << std::endl;
+            quality_sum += quality_score;
+        }
+        out << "Sum of blueprint qualities: " << quality_sum << std::endl;
+    }else{
+        //For part 2, calculate the product of geodes collected by only the first 3 blueprints
+        int geode_product = 1;
+        for(int i = 0; i<n_blueprints; i++){
+            geode_product *= geodes[i];
+            out << "Maximum geodes collected with blueprint " << blueprints[i].id << " : " << geodes[i] << std::endl;
+        }
+        out << "Product of collected geodes: " << geode_product << std::endl;
+    }
+}
+
+//Not Enough Minerals
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    
+    std::string_view line;
+
+    //Input follows this pattern
+    static constexpr char line_pattern[] = "Blueprint {u}: Each ore robot costs {u} ore. Each clay robot costs {u} ore. Each obsidian robot costs {u} ore and {u} clay. Each geode robot costs {u} ore and {u} obsidian.";
+
+    std::vector<Blueprint> blueprints;
+    
+    //Read in the data
+    while(input.getline(line)){
+        //Store blueprint data
+        Blueprint blueprint;
+        bool matched = aoc::Pattern<line_pattern>::match(line,
+            blueprint.id,
+            blueprint.bots[ore     ].cost[ore     ],
+            blueprint.bots[clay    ].cost[ore     ],
+            blueprint.bots[obsidian].cost[ore     ],
+            blueprint.bots[obsidian].cost[clay    ],
+            blueprint.bots[geode   ].cost[ore     ],
+            blueprint.bots[geode   ].cost[obsidian]
+        );
+        if(!matched){
+            throw std::runtime_error("Pattern match failed while parsing input!");
+        }
+        
+        //Determine the maximum amount of resources any bot in this template costs
+        for(int i = 0; i<4; i++){
+            blueprint.max_cost = (blueprint.max_cost).cwiseMax(blueprint.bots[i].cost);
+        }
+
+        blueprints.push_back(blueprint);
+    }
+
+    timer.phase("parse");
+
+    aoc::for_each_part(part,[&](auto p){
+        evaluate_blueprints<decltype(p)::value>(blueprints,out);
+    });
+    
+    timer.phase("solve");
+}
+}
\ No newline at end of file
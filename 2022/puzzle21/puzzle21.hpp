@@ -0,0 +1,35 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include "aoc_utility.hpp"
+
+//Monkey Math
+namespace puzzle21{
+    //Solve the given part (1, 2, or aoc::all_parts for both) of the puzzle
+    //for the given input, and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Kernels of the solver (also measured by aoc_microbench)
+
+    //A monkey that will perform some math operation (+,-,*,/,=)
+    struct MathMonkey{
+        char operation;
+        std::string monkey1;
+        std::string monkey2;
+    };
+
+    //A monkey that will only yell a certain number
+    struct YellMonkey{
+        long long number;
+    };
+
+    //Use a map, with as keys the monkey names, and as values the monkey. An
+    //std::variant is used, such that both types of monkey can be stored in this map.
+    using monkey_list = std::unordered_map<std::string,std::variant<MathMonkey,YellMonkey>>;
+
+    //The value a monkey yells, computed as T (long long or double)
+    template<typename T>
+    T resolve_monkey(const monkey_list& monkeys, const std::string& monkey);
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+#include <ostream>
+#include <Eigen/Core>
+#include "aoc_utility.hpp"
+
+//Monkey Map
+namespace puzzle22{
+    //Solve the given part (1, 2, or aoc::all_parts for both) of the puzzle
+    //for the given input, and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Kernels of the solver (also measured by aoc_microbench)
+
+    //Rotation matrix for rotation around z-axis
+    Eigen::Matrix3d Rz(double theta_deg);
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "puzzle3.hpp"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include "aoc_utility.hpp"
+
+namespace puzzle3{
+
+//Translate from character to item priority:
+//  a-z ->  1 - 26
+//  A-Z -> 27 - 52
+int priority(char item){
+    if(islower(item)){
+        return item - 'a' + 1;
+    }else if(isupper(item)){
+        return item - 'A' + 27;
+    }else{
+        throw std::runtime_error("illegal item in rucksack (not a-z A-Z)");
+    }
+}
+
+//Fill the rucksack with items from string. Clear first and sort contents after
+//(needed for the set operations we will be using)
+rucksack fill_rucksack(std::string_view items){
+    rucksack new_rucksack(items.size());
+    for(int i = 0; i<items.length(); i++){
+        new_rucksack[i] = priority(items[i]);
+    }
+    std::sort(new_rucksack.begin(),new_rucksack.end());
+    return new_rucksack;
+}
+
+//Check which items are duplicate between two rucksacks (or compartments).
+//This requires that the rucksacks are already sorted. A new rucksack 
+//will be returned, only containing the duplicate item(s)
+rucksack duplicate_items(const rucksack& rucksack1, const rucksack& rucksack2){
+        
+    //Check if rucksacks are sorted (needed for set_intersection)
+    if(!std::is_sorted(rucksack1.begin(),rucksack1.end())){
+        throw std::runtime_error("rucksack1 is not sorted!");
+    }
+    if(!std::is_sorted(rucksack2.begin(),rucksack2.end())){
+        throw std::runtime_error("rucksack2 is not sorted!");
+    }
+
+    //Calculate which elements are present in both lists (sets)
+    //C++ can do this with the set_intersection algorithm
+    rucksack intersection;
+    std::set_intersection(  rucksack1.begin(),rucksack1.end(),
+                            rucksack2.begin(),rucksack2.end(),
+                            std::back_inserter(intersection));
+
+    //Remove potential duplicates from intersection
+    //(example:  AAAbcd  frAAg -> intersection would be AA)
+    std::sort(intersection.begin(), intersection.end());
+    auto last = std::unique(intersection.begin(), intersection.end());
+    intersection.erase(last, intersection.end());
+    
+    return intersection;
+}
+
+
+//Sum the duplicate items (part 1) and the badge items (part 2) in a single
+//pass: part 1 looks at one line at a time, part 2 at groups of three lines.
+//Input is an aoc::InputView, or an aoc::InputStream (--stream).
+template<typename Input>
+void sum_items(Input& input, std::ostream& out){
+
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //The input is parsed while solving, so only mapping the file counts as parsing
+    timer.phase("parse");
+
+    //Pre-declare rucksacks
+    rucksack items_comp1;   //items in compartment 1 (part 1)
+    rucksack items_comp2;   //items in compartment 2 (part 1)
+    rucksack rucksack1;     //items in rucksack 1 of the group
+    rucksack rucksack2;     //items in rucksack 2 of the group
+    rucksack rucksack3;     //items in rucksack 3 of the group
+    rucksack duplicates12;  //duplicates between rucksack 1 and 2
+    rucksack duplicates123; //duplicates between all three rucksacks
+
+    std::string_view line;
+    int duplicate_item_sum = 0;
+    int elf_counter = 0;
+    int badge_item_sum = 0;
+    while(input.getline(line)){
+        // --------------------------- part 1 --------------------------------
+
+        //Total number of items in each compartment. Should always be even
+        int N_items = line.size();
+        if(N_items % 2 != 0){
+            throw std::runtime_error("Number of items in rucksack not even!");
+        }
+
+        //Divide the items over the two compartments:
+        // first half of items in compartment 1, rest in compartment 2
+        items_comp1 = fill_rucksack(line.substr(0, N_items/2));
+        items_comp2 = fill_rucksack(line.substr(   N_items/2));
+
+        //Calculate which elements are present in both compartments
+        rucksack intersection = duplicate_items(items_comp1,items_comp2);
+        
+        //Check the elf's bad work
+        if(intersection.size() != 1){
+            throw std::runtime_error("Elf packed more than 1 duplicate item!: " + std::string(line));
+        }
+
+        //Add to the sum
+        duplicate_item_sum += intersection[0];
+
+        // --------------------------- part 2 --------------------------------
+
+        switch(elf_counter % 3){
+            case 0:
+                //Elf 1 of 3
+                rucksack1 = fill_rucksack(line);
+                break;
+            case 1:
+                //Elf 2 of 3
+                rucksack2 = fill_rucksack(line);
+                break;
+            case 2:
+                //Elf 3 of 3 -> gather results
+                rucksack3 = fill_rucksack(line);
+                duplicates12  = duplicate_items(rucksack1,rucksack2);
+                duplicates123 = duplicate_items(duplicates12,rucksack3);
+                //Check if indeed only one item is present in threefold
+                if(duplicates123.size() != 1){
+                    throw std::runtime_error("More than 1 item is present in threefold!");
+                }
+                badge_item_sum += duplicates123[0];
+                break;
+            default:
+                break;
+        }
+        elf_counter++;
+    }    
+
+    out << "Sum of duplicate items (part 1):" << duplicate_item_sum << std::endl;
+    out << "Sum of badge items (part 2):" << badge_item_sum << std::endl;
+
+    timer.phase("solve");
+}
+
+//Rucksack Reorganization
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+    sum_items(input,out);
+}
+
+void solve_stream(aoc::InputStream& input, std::ostream& out){
+    sum_items(input,out);
+}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include <ostream>
+#include <vector>
+#include <string_view>
+#include "aoc_utility.hpp"
+
+//Rucksack Reorganization
+namespace puzzle3{
+    //Solve the puzzle for the given input (both parts are always solved, the
+    //part number is ignored), and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Solve both parts in a single pass over the input, in constant memory
+    //(--stream), and write the results to out
+    void solve_stream(aoc::InputStream& input, std::ostream& out);
+
+    //Kernels of the solver (also measured by aoc_microbench)
+    using rucksack = std::vector<int>;
+    int priority(char item);
+    rucksack fill_rucksack(std::string_view items);
+}
\ No newline at end of file
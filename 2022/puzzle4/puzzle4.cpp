@@ -0,0 +1,72 @@
+#include "puzzle4.hpp"
+#include <iostream>
+#include <string>
+#include "aoc_utility.hpp"
+
+namespace puzzle4{
+
+//Check if range1 fully contains range2, or vice versa
+bool full_range_overlap(int start1, int end1, int start2, int end2){
+    return (start1>=start2 && end1<=end2) ||
+           (start2>=start1 && end2<=end1) ;
+}
+
+//Check if range1 fully contains range2, or vice versa
+bool partial_range_overlap(int start1, int end1, int start2, int end2){
+    //See https://nedbatchelder.com/blog/201310/range_overlap_in_two_compares.html
+    //Instead of thinking when ranges DO overlap, it is easier to consider when they DON'T
+    //Ranges do NOT overlap if entire range 1 < range 2 (or vice versa)
+    // --> return !(end1 < start2 || end2 < start1)
+    //Or, equivalently: (using de Morgan's laws (negation of a disjunction: !(A v B) = (!A & !B))    
+    return (end1 >= start2) && (end2 >= start1);
+}
+
+//Count the overlapping assignments, line by line. Input is an aoc::InputView,
+//or an aoc::InputStream (--stream): the input is only read once.
+template<typename Input>
+void count_overlaps(Input& input, std::ostream& out){
+
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //The input is parsed while solving, so only mapping the file counts as parsing
+    timer.phase("parse");
+    
+    std::string_view line;
+    int N_full_overlap=0;
+    int N_partial_overlap=0;
+    while(input.getline(line)){
+        //Input lines look like 2-4,6-8
+        aoc::Scanner scanner(line);
+
+        //Plots for elf 1 (delimited with '-')
+        int elf1_plot1 = scanner.next_int<unsigned>();
+        scanner.expect("-");
+        int elf1_plot2 = scanner.next_int<unsigned>();
+        scanner.expect(",");
+
+        //Plots for elf 2 (delimited with '-')
+        int elf2_plot1 = scanner.next_int<unsigned>();
+        scanner.expect("-");
+        int elf2_plot2 = scanner.next_int<unsigned>();
+
+        //Now check if a range is overlapping
+        N_full_overlap    +=    full_range_overlap(elf1_plot1,elf1_plot2,elf2_plot1,elf2_plot2);
+        N_partial_overlap += partial_range_overlap(elf1_plot1,elf1_plot2,elf2_plot1,elf2_plot2);
+    }
+
+    out << "number of fully overlapping tasks is  "  << N_full_overlap << std::endl;
+    out << "number of partial overlapping tasks is " << N_partial_overlap << std::endl;
+        
+    timer.phase("solve");
+}
+
+//Camp Cleanup
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+    count_overlaps(input,out);
+}
+
+void solve_stream(aoc::InputStream& input, std::ostream& out){
+    count_overlaps(input,out);
+}
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "puzzle5.hpp"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <deque>
+#include "aoc_utility.hpp"
+#include "aoc_pattern.hpp"
+
+namespace puzzle5{
+
+//To store the crate, use a vector of deques. A deque is nice for this 
+//assignment, because you can push/pop elements from both sides
+using crate_stacks = std::vector<std::deque<char>>;
+
+//TODO: would be nice if this was determined from input
+const int N_crates = 9;
+
+//Print the current crate configuration, and the "message" (the top crates)
+void print_configuration(std::ostream& out, const crate_stacks &crates){
+    //Print the crate configuration (top crates are the leftmost crates)
+    for(int i = 0; i<crates.size(); i++){
+        out << i << ": ";
+        for(int j = 0; j<crates[i].size(); j++){
+            out << "["<<crates[i][j] << "] , ";
+        }
+        out << std::endl;
+    }
+    //Print the message / solution
+    out << "message: ";
+    for(int i = 0; i<crates.size(); i++){
+        out << crates[i][0];
+    }
+    out << std::endl;
+}
+
+//A move of the crane
+struct Move{
+    int quantity;       //Number of crates to be moved
+    int source_stack;   //Source stack
+    int target_stack;   //Target stack
+};
+
+//Shuffle the crates with the crane
+void move_crates(crate_stacks& crates, const std::vector<Move>& moves, int part){
+    for(const auto& move : moves){
+        //part 1: the crane moves the crates one by one
+        if(part == 1){
+            for(int i=0; i<move.quantity; i++){
+                //get label of top crate on the source stack
+                char crate_label = crates[move.source_stack-1][0];
+                //take this crate from the source stack, add it to the target stack
+                crates[move.source_stack-1].pop_front();
+                crates[move.target_stack-1].push_front(crate_label);
+            }
+        }
+       
+        //part 2: the crane moves all crates at once
+        if(part == 2){
+            //First add the crates "in reverse order" to the target stack
+            //Not the nicest way to do it, but okay..
+            for(int i=0; i<move.quantity; i++){
+                char crate_label = crates[move.source_stack-1][move.quantity-i-1];                
+                crates[move.target_stack-1].push_front(crate_label);
+            }
+            //Delete the crates from the source stack
+            for(int i=0; i<move.quantity; i++){
+                crates[move.source_stack-1].pop_front();
+            }
+        }
+    }
+}
+
+/*
+    Stacking crates..
+    Both parts start from the same parsed crates and moves
+*/
+void solve(aoc::InputView& input, int part, std::ostream& out){
+
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+   
+    std::string_view line;
+    bool move_mode = false;
+    crate_stacks crates(N_crates);
+    std::vector<Move> moves;
+
+    //The lines that describe the moves look as follows:
+    static constexpr char move_pattern[] = "move {u} from {u} to {u}";
+    while(input.getline(line)){        
+        if(!move_mode){
+            //"arrangement mode": load the initial configuration of the crates
+            for(int i = 0; i<crates.size(); i++){
+                char crate_label = line[i*4+1];
+                if(crate_label >= 'A' && crate_label <= 'Z'){
+                    crates[i].push_back(crate_label);
+                }                
+            }
+        }else{
+            //"move mode": extract the move
+            Move move;
+            if(!aoc::Pattern<move_pattern>::match(line,move.quantity,move.source_stack,move.target_stack)){
+                throw std::runtime_error("Pattern match failed while parsing input!");
+            }
+            moves.push_back(move);
+        }
+
+        //and of arrangement mode, enable "move mode"
+        if(line == ""){
+            move_mode = true;
+        }
+    }
+
+    timer.phase("parse");
+
+    for(int p : aoc::parts(part)){
+        //Print the configuration before shuffling crates
+        out << "configuration before shuffling crates:" << std::endl;
+        print_configuration(out,crates);       
+
+        //Start shuffling a copy of the crates with the crane
+        crate_stacks shuffled = crates;
+        move_crates(shuffled,moves,p);
+
+        //Plot the final solution
+        out << "configuration after shuffling crates:" << std::endl;
+        print_configuration(out,shuffled);    
+    }
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "puzzle6.hpp"
+#include <iostream>
+#include <string>
+#include <deque>
+#include <algorithm>
+#include <set>
+#include <array>
+#include "aoc_utility.hpp"
+
+namespace puzzle6{
+
+//Check if all characters in the buffer are unique by placing them into
+//an std::set. A std::set doesn't allow duplicates. Another solution is
+//to use std::unique, but that requires the data to be sorted first.
+//Both methods have roughly NlogN complexity however (inserting into a 
+//set has a complexity of logN according to cppreference)
+bool all_chars_unique(std::deque<char> buffer){
+    std::set<char> unique_chars;
+    for(char c:buffer){
+        unique_chars.insert(c);
+    }
+    return unique_chars.size() == buffer.size();
+}
+
+//Find the first position after a marker of marker_length unique characters
+void find_marker(std::string_view line, int marker_length, std::ostream& out){
+    //Create the buffer of appropriate length
+    std::deque<char> buffer(marker_length);
+    
+    int counter = 1;
+    for(char c:line){
+        //Shift all characters in the buffer one to the left (by pushing the new
+        //character at the back, and popping the oldest character from the front)
+        buffer.push_back(c);
+        buffer.pop_front();
+        //Check if we found the marker
+        if(all_chars_unique(buffer) && counter > buffer.size()){
+            out << "marker found at " << counter << std::endl;
+            break;
+        }  
+        counter++;
+    }
+}
+
+//Sliding window over the last K characters of a stream, which keeps track
+//of whether they are all different in O(1) per character (the count of
+//every character, and the number of characters that occur more than once)
+template<int K>
+class MarkerWindow{
+public:
+    //Add the next character, the oldest one drops out. Returns true if the
+    //last K characters are all different.
+    bool push(char c){
+        if(n_chars >= K){
+            unsigned char oldest = window[n_chars % K];
+            if(--counts[oldest] == 1){
+                n_repeated--;
+            }
+        }
+        window[n_chars % K] = c;
+        if(++counts[static_cast<unsigned char>(c)] == 2){
+            n_repeated++;
+        }
+        n_chars++;
+        return n_chars >= K && n_repeated == 0;
+    }
+
+private:
+    std::array<int,256> counts{};
+    std::array<char,K>  window{};
+    int n_repeated    = 0;
+    long long n_chars = 0;
+};
+
+//Decode the elves's data stream
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    std::string_view line;
+    input.getline(line);    
+
+    timer.phase("parse");
+
+    //The marker is 4 characters long for part 1, and 14 for part 2
+    for(int p : aoc::parts(part)){
+        find_marker(line,p == 1 ? 4 : 14,out);
+    }
+    timer.phase("solve");
+}
+
+//Find both markers in a single pass over the (first line of the) input. The
+//marker of part 1 always comes first, since the last 4 characters of the
+//marker of part 2 are all different as well.
+void solve_stream(aoc::InputStream& input, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //The input is parsed while solving, so only opening the input counts as parsing
+    timer.phase("parse");
+
+    MarkerWindow<4>  window1;
+    MarkerWindow<14> window2;
+    bool found1 = false;
+    bool found2 = false;
+    long long counter = 1;
+    std::string_view chunk;
+    while(!found2 && input.read(chunk)){
+        for(char c : chunk){
+            if(c == '\n'){
+                found2 = true;  //End of the data stream
+                break;
+            }
+            //As in find_marker, a marker only counts after the first K characters
+            if(window1.push(c) && !found1 && counter > 4){
+                out << "marker found at " << counter << std::endl;
+                found1 = true;
+            }
+            if(window2.push(c) && counter > 14){
+                out << "marker found at " << counter << std::endl;
+                found2 = true;
+                break;
+            }
+            counter++;
+        }
+    }
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+#include <ostream>
+#include <deque>
+#include "aoc_utility.hpp"
+
+//Tuning Trouble
+namespace puzzle6{
+    //Solve the given part (1, 2, or aoc::all_parts for both) of the puzzle
+    //for the given input, and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Solve both parts in a single pass over the input, in constant memory
+    //(--stream), and write the results to out
+    void solve_stream(aoc::InputStream& input, std::ostream& out);
+
+    //Kernels of the solver (also measured by aoc_microbench)
+    bool all_chars_unique(std::deque<char> buffer);
+}
\ No newline at end of file
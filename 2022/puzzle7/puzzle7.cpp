@@ -0,0 +1,111 @@
+#include "puzzle7.hpp"
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include "aoc_utility.hpp"
+#include "aoc_hash.hpp"
+#include "aoc_flat_map.hpp"
+
+namespace puzzle7{
+
+//A directory is identified by the index of its parent directory (-1 for the
+//root), and its name
+using directory_key = std::pair<int,std::string_view>;
+
+struct DirectoryHash{
+    uint64_t operator()(const directory_key& key) const{
+        return aoc::hash64(key.second,static_cast<uint64_t>(key.first));
+    }
+};
+
+//Examine an elf filesystem
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+
+    //Current working directory, stored as a stack of directory indices, so
+    //we can push and pop to it while cd'ing
+    std::vector<int> cwd;
+
+    //The total folder size per (nested) directory, and the index of each
+    //directory in it. The names point into the input, which outlives the solve.
+    std::vector<int> dir_sizes;
+    aoc::FlatMap<directory_key,int,DirectoryHash> dir_index;
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    //The input is parsed while solving, so only mapping the file counts as parsing
+    timer.phase("parse");
+    std::string_view line;
+    int total_file_size = 0;
+    while(input.getline(line)){
+        if(line[0] == '$'){
+            std::string_view command = line.substr(2,2);
+            //Command encountered
+            if(command == "cd"){
+                std::string_view dirname = line.substr(5);               
+                if(dirname == ".."){
+                    //Go back a directory --> pop
+                    cwd.pop_back();
+                }else if(dirname != "/"){
+                    //Dive into a directory --> push
+                    //Also set the size for the new subdirectory to 0
+                    directory_key key{cwd.empty() ? -1 : cwd.back(),dirname};
+                    auto [index,inserted] = dir_index.try_emplace(key,dir_sizes.size());
+                    if(inserted){
+                        dir_sizes.push_back(0);
+                    }
+                    dir_sizes[*index] = 0;
+                    cwd.push_back(*index);
+                }        
+            }
+        }else{
+            //Output
+            
+            //Output is either "dir <name>" or "<size> <name>"
+            aoc::Scanner scanner(line);
+            if(!scanner.starts_with("dir")){
+                //File size found
+                int filesize = scanner.next_int<unsigned>();
+
+                //Add to the total filesystem size
+                total_file_size += filesize;
+
+                //Add the filesize to the current working directory,
+                //and propagate the filesize to all parent directories
+                for(int dir : cwd){
+                    dir_sizes[dir] += filesize;
+                }            
+            }
+        }    
+    }   
+
+
+    //Copy of the values from the hashmap into a vector for part 2
+    std::vector<int> dir_sizes_vector;
+
+    //Find the sum of sizes of all folders smaller than 100kB
+    int answer_part_1 = 0;
+    for(int dir_size : dir_sizes){
+        dir_sizes_vector.push_back(dir_size);
+        if(dir_size <= 100000){            
+            answer_part_1 += dir_size;
+        }
+    }
+    out << "Sum of directories smaller than 100kB: " << answer_part_1 << std::endl;
+
+    //Calculate the space we need to save
+    int fs_size         = 70000000;
+    int required_space  = 30000000;
+    int required_save   = total_file_size - (fs_size-required_space);
+    out << "Total used space by all files: " << total_file_size << std::endl;
+    out << "Need to save: " << required_save << " bytes" << std::endl;
+
+    //Find the smallest directory that can achieve this save
+    std::sort(dir_sizes_vector.begin(),dir_sizes_vector.end());
+    auto it =  std::upper_bound(dir_sizes_vector.begin(),dir_sizes_vector.end(),required_save);
+    out << "Smallest folder to remove: " << *it << std::endl;
+   
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "puzzle8.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include "aoc_utility.hpp"
+#include "aoc_grid.hpp"
+
+namespace puzzle8{
+
+
+//Examine an elf filesystem
+void solve(aoc::InputView& input, int /*part*/, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+    
+    //Load the trees into a grid (the heights are the characters '0' to '9')
+    auto trees = aoc::Grid<char>::from_text(input.data());
+
+    timer.phase("parse");
+
+    //Now determine for every tree whether it is obstructed, and calculate the scenic score.
+    int n_not_obstructed = 0;
+    int max_scenic_score = 0;
+    const int N_rows = trees.rows();
+    const int N_cols = trees.cols();
+    for(int row = 0; row<N_rows; row++){
+        //The trees in the same row and column as this tree
+        auto tree_row = trees.row(row);
+        for(int column = 0; column<N_cols; column++){
+            auto tree_column = trees.column(column);
+
+            int tree_height = tree_row[column];
+            
+            bool obstructed_north = false;
+            int scenic_score_north = 0;
+            //check not obstructed in the north direction
+            for(int i = row-1; i>=0; i--){                
+                scenic_score_north++;
+                if(tree_height <= tree_column[i]){
+                    obstructed_north = true;
+                    break;
+                }
+            }
+
+            bool obstructed_south = false;
+            int scenic_score_south = 0;
+            //check not obstructed in the south direction
+            for(int i = row+1; i<N_rows; i++){                
+                scenic_score_south++;
+                if(tree_height <= tree_column[i]){
+                    obstructed_south = true;
+                    break;
+                }
+            }
+
+            bool obstructed_east = false;
+            int scenic_score_east = 0;
+            //check not obstructed in the east direction
+            for(int i = column-1; i>=0; i--){                
+                scenic_score_east++;
+                if(tree_height <= tree_row[i]){
+                    obstructed_east = true;
+                    break;
+                }
+            }
+
+            bool obstructed_west = false;
+            int scenic_score_west = 0;
+            //check not obstructed in the west direction
+            for(int i = column+1; i<N_cols; i++){
+                scenic_score_west++;
+                if(tree_height <= tree_row[i]){
+                    obstructed_west = true;
+                    break;
+                }                
+            }
+
+            //Calculate the "scenic score" for this tree
+            int scenic_score = scenic_score_north*scenic_score_south*scenic_score_east*scenic_score_west;
+            if(scenic_score > max_scenic_score){
+                max_scenic_score = scenic_score;
+            }
+
+            //Determine if this tree is obstructed
+            n_not_obstructed += (!obstructed_north || !obstructed_south || !obstructed_east || !obstructed_west);
+
+        }
+    }
+
+    out << "The number of unobstructed trees: " << n_not_obstructed << std::endl;
+    out << "The maximum scenic score is: " << max_scenic_score << std::endl;
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
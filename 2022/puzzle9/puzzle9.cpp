@@ -0,0 +1,130 @@
+#include "puzzle9.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include "aoc_utility.hpp"
+#include "aoc_flat_map.hpp"
+
+namespace puzzle9{
+
+//Returns the sign of the number:
+// +1 for positive numbers
+// -1 for negative numbers
+//  0 for.. 0
+int sign(int number){
+    if(number < 0){
+        return -1;
+    }else if(number > 0){
+        return 1;
+    }else{
+        return 0;
+    }
+}
+
+//Update the tail position. If the tail is touching the 
+//preceding 
+void update_tail(const node& head, node& tail){
+    int dx    = head.x-tail.x;
+    int dy    = head.y-tail.y;
+
+    //Calculate squared distance
+    int dist2 = dx*dx + dy*dy;
+    
+    if(dist2 <= 2){
+        //Head and tail are touching -> nothing to do
+        return;
+    }
+
+    //Update tail position
+    tail.y += sign(dy);
+    tail.x += sign(dx);    
+}
+
+//A move of the head of the rope
+struct Move{
+    char direction;
+    int  steps;
+};
+
+//Decode the elves's data stream
+//Solves part 1, part 2, or both parts (part = aoc::all_parts)
+void solve(aoc::InputView& input, int part, std::ostream& out){
+    
+    //Time the parse and solve phases (reported to aoc_bench)
+    aoc::PhaseTimer timer;
+
+    std::string_view line;
+    std::vector<Move> moves;
+    while(input.getline(line)){
+        aoc::Scanner scanner(line);
+        char direction = scanner.next_char();
+        int  steps     = scanner.next_int<unsigned>();
+        moves.push_back({direction,steps});
+    }
+
+    timer.phase("parse");
+
+    //Keep track of which squares have been visited by the head and tail nodes.
+    //The tail of the part 1 rope (2 nodes) is the second node of the part 2
+    //rope (10 nodes), so a single simulation covers both parts.
+    //Positions are stored as packed (x,y) keys.
+    aoc::FlatSet<uint64_t> head_visited;
+    aoc::FlatSet<uint64_t> tail_visited[2];
+
+    //Chain of nodes
+    std::vector<node> nodes;
+    if(part == 1){
+        nodes.resize(2);
+    }else{
+        nodes.resize(10);
+    }
+
+    //The parts whose tail is tracked (looked up once, not every step)
+    const std::vector<int> tracked_parts = aoc::parts(part);
+
+    for(const auto& move : moves){
+        for(int step = 0; step<move.steps; step++){
+            //Update the head position
+            node& head = *nodes.begin();
+            switch(move.direction){
+                case 'U':
+                    head.y++;
+                    break;
+                case 'D':
+                    head.y--;
+                    break;
+                case 'L':
+                    head.x--;
+                    break;
+                case 'R':
+                    head.x++;
+                    break;
+                default:
+                    throw std::runtime_error("Illegal move direction!!");
+            
+            } 
+
+            //Update the other nodes
+            for(int i = 0; i<nodes.size()-1; i++){
+                update_tail(nodes[i],nodes[i+1]);
+            }           
+            
+            //Register the head and tail positions
+            head_visited.insert(aoc::pack_xy(head.x,head.y));
+            for(int p : tracked_parts){
+                const node& tail = (p == 1) ? nodes[1] : nodes[9];
+                tail_visited[p-1].insert(aoc::pack_xy(tail.x,tail.y));
+            }
+        }
+    }   
+
+    for(int p : tracked_parts){
+        out << "head visited: " << head_visited.size() << " locations" << std::endl;
+        out << "tail visited: " << tail_visited[p-1].size() << " locations" << std::endl;
+    }
+
+    timer.phase("solve");
+}
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include <ostream>
+#include "aoc_utility.hpp"
+
+//Rope Bridge
+namespace puzzle9{
+    //Solve the given part (1, 2, or aoc::all_parts for both) of the puzzle
+    //for the given input, and write the results to out
+    void solve(aoc::InputView& input, int part, std::ostream& out);
+
+    //Kernels of the solver (also measured by aoc_microbench)
+
+    //Type of the node of the rope
+    struct node{    
+        int x = 0;
+        int y = 0;    
+    };
+
+    //Move the tail one step towards the head, if they are not touching
+    void update_tail(const node& head, node& tail);
+}
\ No newline at end of file
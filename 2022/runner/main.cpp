@@ -0,0 +1,189 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include "aoc_utility.hpp"
+#include "aoc_tasks.hpp"
+
+//Generated by CMake: the headers of all puzzles
+#include "solver_headers.inc"
+
+//A puzzle registered with aoc_add_solver (see CMakeLists.txt)
+struct Solver{
+    std::string puzzle;         //Puzzle name, e.g. puzzle6
+    aoc::SolveFunction solve;   //Solve function of the puzzle
+    std::string input_file;     //Full path to the input file
+};
+
+//Generated by CMake
+const std::vector<Solver> solvers = {
+    #include "solvers.inc"
+};
+
+//A single puzzle run, and its results
+struct Job{
+    Job(const Solver* solver, int part) : solver(solver), part(part){}
+
+    const Solver* solver;
+    int part;
+    std::string output;         //Everything the puzzle wrote
+    std::string error;          //Exception message, if the puzzle failed
+    long long ns = 0;           //Time spent in the puzzle (including loading the input)
+    bool done = false;
+};
+
+//Runner settings
+struct Settings{
+    unsigned n_threads = aoc::TaskPool::default_threads();
+    bool quiet = false;
+    std::vector<std::string> filters;
+};
+
+std::string part_name(int part){
+    return (part == aoc::all_parts) ? "all" : std::to_string(part);
+}
+
+//The parts of this puzzle that were selected on the command line. Filters are
+//either a puzzle (puzzle6, both parts in one run) or a puzzle and part
+//(puzzle6/2, or puzzle6/all). Without filters, all puzzles are selected.
+std::vector<int> selected_parts(const Solver& solver, const Settings& settings){
+    if(settings.filters.empty()){
+        return {aoc::all_parts};
+    }
+    std::vector<int> parts;
+    for(int part : {aoc::all_parts,1,2}){
+        for(const auto& filter : settings.filters){
+            bool whole_puzzle = (filter == solver.puzzle) && (part == aoc::all_parts);
+            if(whole_puzzle || filter == solver.puzzle + "/" + part_name(part)){
+                parts.push_back(part);
+                break;
+            }
+        }
+    }
+    return parts;
+}
+
+//Puzzle number, used to sort puzzle10 after puzzle9
+int puzzle_number(const std::string& puzzle){
+    size_t digits = puzzle.find_first_of("0123456789");
+    return (digits == std::string::npos) ? 0 : std::stoi(puzzle.substr(digits));
+}
+
+//Run a single puzzle part. The output is captured, so that the results of
+//puzzles that run concurrently do not get mixed up.
+void run_job(Job& job){
+    std::ostringstream out;
+    auto start = std::chrono::steady_clock::now();
+    try{
+        aoc::InputView input(job.solver->input_file);
+        job.solver->solve(input,job.part,out);
+    }catch(const std::exception& e){
+        job.error = e.what();
+    }
+    auto end = std::chrono::steady_clock::now();
+    job.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    job.output = out.str();
+}
+
+void print_usage(){
+    std::cout << "Usage: ./aoc_all [--threads N] [--quiet] [--list] [puzzle[/part] ...]" << std::endl;
+    std::cout << "Solves all puzzles (or the selected ones) in a single process, running them" << std::endl;
+    std::cout << "concurrently on N threads (default: number of hardware threads). The results" << std::endl;
+    std::cout << "are printed in puzzle order." << std::endl;
+}
+
+//In-process runner for all puzzles
+int main(int argc, char *argv[]){
+
+    //Parse the program arguments
+    Settings settings;
+    for(int i = 1; i<argc; i++){
+        std::string arg = argv[i];
+        if(arg == "--threads"){
+            if(i+1 >= argc){
+                throw std::runtime_error("Missing value for " + arg);
+            }
+            settings.n_threads = std::max(1,std::stoi(argv[++i]));
+        }else if(arg == "--quiet"){
+            settings.quiet = true;
+        }else if(arg == "--list"){
+            for(const auto& solver : solvers){
+                std::cout << solver.puzzle << std::endl;
+            }
+            return 0;
+        }else if(arg == "--help" || arg == "-h"){
+            print_usage();
+            return 0;
+        }else{
+            settings.filters.push_back(arg);
+        }
+    }
+
+    //One job per puzzle (both parts), or per selected part, in numerical order
+    std::vector<const Solver*> ordered;
+    for(const auto& solver : solvers){
+        ordered.push_back(&solver);
+    }
+    std::stable_sort(ordered.begin(),ordered.end(),[](const Solver* a, const Solver* b){
+        return puzzle_number(a->puzzle) < puzzle_number(b->puzzle);
+    });
+    std::vector<Job> jobs;
+    for(const Solver* solver_ptr : ordered){
+        const Solver& solver = *solver_ptr;
+        for(int part : selected_parts(solver,settings)){
+            jobs.emplace_back(&solver,part);
+        }
+    }
+
+    //Every job is a task in the shared task pool, which the puzzles also use
+    //for their own parallel loops
+    aoc::TaskPool::set_global_threads(settings.n_threads);
+    aoc::TaskPool& pool = aoc::TaskPool::global();
+    std::mutex mutex;
+    std::condition_variable job_done;
+
+    auto start = std::chrono::steady_clock::now();
+    aoc::TaskGroup group(pool);
+    for(auto& job : jobs){
+        group.spawn([&job,&mutex,&job_done](){
+            run_job(job);
+            std::lock_guard<std::mutex> lock(mutex);
+            job.done = true;
+            job_done.notify_one();
+        });
+    }
+
+    //Print the results in a stable order, as soon as they are available
+    int n_failed = 0;
+    long long total_ns = 0;
+    for(auto& job : jobs){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            job_done.wait(lock,[&job](){ return job.done; });
+        }
+        total_ns += job.ns;
+        std::cout << "==== " << job.solver->puzzle << " part " << part_name(job.part)
+                  << " (" << std::fixed << std::setprecision(3) << job.ns/1e6 << " ms)" << std::endl;
+        if(!settings.quiet){
+            std::cout << job.output;
+        }
+        if(!job.error.empty()){
+            std::cout << "FAILED: " << job.error << std::endl;
+            n_failed++;
+        }
+    }
+    group.sync();
+    auto end = std::chrono::steady_clock::now();
+    long long wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::cout << "==== " << jobs.size() << " puzzle runs on " << pool.size() << " threads: wall time "
+              << std::fixed << std::setprecision(3) << wall_ns/1e6 << " ms, sum of puzzle times "
+              << total_ns/1e6 << " ms" << std::endl;
+
+    return n_failed == 0 ? 0 : 1;
+}
\ No newline at end of file
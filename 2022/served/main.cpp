@@ -0,0 +1,610 @@
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <filesystem>
+#include <array>
+#include <limits>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <signal.h>
+#include "aoc_utility.hpp"
+#include "aoc_tasks.hpp"
+
+//Generated by CMake: the headers of all puzzles
+#include "solver_headers.inc"
+
+/*
+    Solver daemon: keeps all puzzles loaded, and solves them on request.
+    Clients connect to a Unix domain socket, and send requests of a single
+    line. A connection can be used for any number of requests, which are
+    answered in order. The requests of different connections are solved
+    concurrently on a pool of request threads. The global task pool is only
+    used by the puzzles themselves (parallel_for and the like): a request
+    that waits for its own tasks never picks up another client's request.
+
+    Requests:
+        solve <puzzle> <part> <path>        Solve the input file at path
+                                            (relative to the server's directory,
+                                            and inside it)
+        solve <puzzle> <part> - <bytes>     Solve the input that follows the
+                                            request line (exactly <bytes> bytes)
+        stats                               Latency statistics per puzzle part
+        list                                Names of the puzzles
+        shutdown                            Stop the server
+
+    The part is 1, 2 or all. Every response starts with a single line:
+        ok <bytes> [<name>=<ns> ...]        Followed by <bytes> bytes of output
+        error <bytes>                       Followed by the error message
+    The timings of a solve are the time spent loading the input (load), the
+    phases reported by the puzzle (parse and solve), and the total time
+    between receiving the request and sending the response (total). Results
+    that came from the result cache (--cache) are marked with cached=1.
+
+    The socket is only accessible to the user that runs the server (0600),
+    and input files outside the server's directory (absolute paths, or paths
+    with "..") are refused, so clients can not make it read arbitrary files.
+*/
+
+//A puzzle registered with aoc_add_solver (see CMakeLists.txt)
+struct Solver{
+    std::string puzzle;         //Puzzle name, e.g. puzzle6
+    aoc::SolveFunction solve;   //Solve function of the puzzle
+    std::string input_file;     //Full path to the input file
+};
+
+//Generated by CMake
+const std::vector<Solver> solvers = {
+    #include "solvers.inc"
+};
+
+//Server settings
+struct Settings{
+    std::string socket_path = "/tmp/aoc_served.sock";
+    unsigned n_threads = aoc::TaskPool::default_threads();
+    bool cache = false;     //Use the on-disk result cache (aoc_cache.hpp)
+    std::vector<std::string> requests;  //Client mode: requests to send (--send)
+};
+
+//Latencies in logarithmic buckets: 8 buckets per power of two, so a
+//percentile is off by at most 1/8 (12.5%). Uses constant memory, however
+//long the server runs.
+class LatencyHistogram{
+public:
+    void add(long long ns){
+        ns = std::max(ns,1LL);
+        counts[bucket(ns)]++;
+        n++;
+        min_ns = std::min(min_ns,ns);
+        max_ns = std::max(max_ns,ns);
+    }
+
+    long long count() const{
+        return n;
+    }
+
+    long long min() const{
+        return min_ns;
+    }
+
+    long long max() const{
+        return max_ns;
+    }
+
+    //Latency at percentile p (0..1): the upper end of the bucket that holds it
+    long long percentile(double p) const{
+        long long rank = std::min(n-1,static_cast<long long>(p*n));
+        long long seen = 0;
+        for(int i = 0; i<n_buckets; i++){
+            seen += counts[i];
+            if(seen > rank){
+                return std::clamp(bucket_end(i),min_ns,max_ns);
+            }
+        }
+        return max_ns;
+    }
+
+private:
+    static constexpr int sub_buckets = 8;
+    static constexpr int sub_bits    = 3;
+    static constexpr int n_buckets   = 64*sub_buckets;
+
+    //The power of two, and the next 3 bits below the highest bit
+    static int bucket(long long ns){
+        int exponent = 63 - __builtin_clzll(ns);
+        int sub = (exponent >= sub_bits) ? (ns >> (exponent - sub_bits)) : (ns << (sub_bits - exponent));
+        return exponent*sub_buckets + (sub & (sub_buckets - 1));
+    }
+
+    //The largest latency that falls in bucket i
+    static long long bucket_end(int i){
+        int exponent = i / sub_buckets;
+        long long next = static_cast<long long>(sub_buckets + i % sub_buckets + 1) << exponent;
+        return std::max(1LL,(next >> sub_bits) - 1);
+    }
+
+    std::array<long long,n_buckets> counts{};
+    long long n      = 0;
+    long long min_ns = std::numeric_limits<long long>::max();
+    long long max_ns = 0;
+};
+
+//Latency of the solve requests, per puzzle part
+class Statistics{
+public:
+    void record(const std::string& key, long long ns, bool failed){
+        std::lock_guard<std::mutex> lock(mutex);
+        Series& entry = series[key];
+        entry.latencies.add(ns);
+        entry.errors += failed;
+    }
+
+    //One line per puzzle part: number of requests and errors, and the
+    //min / median / p99 / max latency in milliseconds
+    std::string report(int in_flight) const{
+        //Copy the histograms (of fixed size), and format them without the lock
+        std::map<std::string,Series> copy;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            copy = series;
+        }
+        std::ostringstream out;
+        auto uptime = std::chrono::steady_clock::now() - start;
+        out << "uptime_s " << std::chrono::duration_cast<std::chrono::seconds>(uptime).count()
+            << " in_flight " << in_flight << std::endl;
+        out << std::fixed << std::setprecision(3);
+        for(const auto& [key,entry] : copy){
+            const LatencyHistogram& latencies = entry.latencies;
+            out << key << " requests " << latencies.count() << " errors " << entry.errors
+                << " min_ms " << latencies.min()/1e6 << " p50_ms " << latencies.percentile(0.5)/1e6
+                << " p99_ms " << latencies.percentile(0.99)/1e6 << " max_ms " << latencies.max()/1e6 << std::endl;
+        }
+        return out.str();
+    }
+
+private:
+    struct Series{
+        LatencyHistogram latencies;     //In nanoseconds
+        long long errors = 0;
+    };
+    mutable std::mutex mutex;
+    std::map<std::string,Series> series;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+//Buffered reading and writing of a client connection
+class Connection{
+public:
+    explicit Connection(int fd) : fd(fd){}
+
+    //Read a line (without the newline). Returns false if the client is gone
+    bool read_line(std::string& line){
+        size_t end;
+        while((end = buffer.find('\n')) == std::string::npos){
+            if(!fill()){
+                return false;
+            }
+        }
+        line = buffer.substr(0,end);
+        buffer.erase(0,end+1);
+        return true;
+    }
+
+    //Read exactly n bytes. Returns false if the client is gone
+    bool read_bytes(size_t n, std::string& data){
+        while(buffer.size() < n){
+            if(!fill()){
+                return false;
+            }
+        }
+        data = buffer.substr(0,n);
+        buffer.erase(0,n);
+        return true;
+    }
+
+    bool write(const std::string& data){
+        for(size_t done = 0; done<data.size();){
+            ssize_t n = ::send(fd,data.data()+done,data.size()-done,MSG_NOSIGNAL);
+            if(n < 0){
+                if(errno == EINTR){
+                    continue;
+                }
+                return false;
+            }
+            done += n;
+        }
+        return true;
+    }
+
+    //Send a response: the status line, followed by the payload
+    bool respond(const std::string& status, const std::string& payload, const std::string& timings = ""){
+        return write(status + " " + std::to_string(payload.size()) + timings + "\n" + payload);
+    }
+
+private:
+    bool fill(){
+        char chunk[1 << 16];
+        ssize_t n;
+        do{
+            n = ::read(fd,chunk,sizeof(chunk));
+        }while(n < 0 && errno == EINTR);
+        if(n <= 0){
+            return false;
+        }
+        buffer.append(chunk,n);
+        return true;
+    }
+
+    int fd;
+    std::string buffer;     //Received, but not yet consumed
+};
+
+//The result of a solve request
+struct Result{
+    std::string output;                                 //Everything the puzzle wrote
+    std::string error;                                  //Exception message, if the puzzle failed
+    std::vector<std::pair<std::string,long long>> ns;   //Timings (load and the phases)
+    bool cached = false;                                //Output came from the result cache
+};
+
+//Solve a puzzle part for an input file, or for the input in payload (if
+//path is "-"). The output is captured. If a cache is given, a stored result
+//is used if there is one, and a new result is stored.
+void solve(const Solver& solver, int part, const std::string& path, std::string& payload,
+           const aoc::ResultCache* cache, Result& result){
+    std::ostringstream out;
+
+    //Receive the phase timings of this solve
+    aoc::PhaseTimer::Listener listener = [&result](const char* phase, long long ns){
+        result.ns.emplace_back(phase,ns);
+    };
+    aoc::PhaseTimer::Listener* previous = aoc::PhaseTimer::listener();
+    aoc::PhaseTimer::listener() = &listener;
+
+    try{
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<aoc::InputView> input;
+        if(path == "-"){
+            input = std::make_unique<aoc::InputView>(aoc::InputView::FromMemory{},std::move(payload));
+        }else{
+            input = std::make_unique<aoc::InputView>(path);
+        }
+        auto end = std::chrono::steady_clock::now();
+        result.ns.emplace_back("load",std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        if(cache == nullptr){
+            solver.solve(*input,part,out);
+        }else{
+            std::string key = aoc::ResultCache::key(solver.puzzle,part,input->data());
+            std::string output;
+            result.cached = cache->lookup(key,output);
+            if(result.cached){
+                out << output;
+            }else{
+                solver.solve(*input,part,out);
+                cache->store(key,out.str());
+            }
+        }
+    }catch(const std::exception& e){
+        result.error = e.what();
+    }
+
+    aoc::PhaseTimer::listener() = previous;
+    result.output = out.str();
+}
+
+//State shared by all connections
+struct Server{
+    Settings settings;
+    Statistics statistics;
+    std::unique_ptr<aoc::ResultCache> cache;    //Only with --cache
+    std::unique_ptr<aoc::TaskPool> requests;    //Solves the requests
+    std::atomic<int> in_flight{0};
+    std::atomic<bool> stopping{false};
+    int listen_fd = -1;
+
+    //Open client connections, so they can be closed on shutdown
+    std::mutex mutex;
+    std::condition_variable closed;
+    std::set<int> clients;
+
+    //Stop accepting connections, and wake up the clients that wait for a request
+    void stop(){
+        stopping = true;
+        ::shutdown(listen_fd,SHUT_RDWR);
+        std::lock_guard<std::mutex> lock(mutex);
+        for(int fd : clients){
+            ::shutdown(fd,SHUT_RD);
+        }
+    }
+};
+
+//Whether path stays inside the server's directory: it is relative, and does
+//not go up a directory anywhere
+bool inside_server_directory(const std::string& path){
+    std::filesystem::path file(path);
+    if(file.empty() || file.has_root_path()){
+        return false;
+    }
+    for(const auto& part : file){
+        if(part == ".."){
+            return false;
+        }
+    }
+    return true;
+}
+
+//Handle a single "solve" request. Returns false if the client is gone.
+bool handle_solve(Server& server, Connection& connection, std::istringstream& request,
+                  std::chrono::steady_clock::time_point received){
+    std::string puzzle, part_name, path;
+    request >> puzzle >> part_name >> std::ws;
+    std::getline(request,path);
+
+    //Inline input: read the payload before anything else, to stay in sync
+    //with the client, even if the request turns out to be invalid
+    std::string payload;
+    if(path.rfind("- ",0) == 0){
+        size_t n_bytes = std::stoull(path.substr(2));
+        path = "-";
+        if(!connection.read_bytes(n_bytes,payload)){
+            return false;
+        }
+    }else if(path.empty() || path == "-"){
+        return connection.respond("error","Usage: solve <puzzle> <part> <path>  or  solve <puzzle> <part> - <bytes>");
+    }else if(!inside_server_directory(path)){
+        return connection.respond("error","Input files must be inside the server's directory (" + path + ")");
+    }
+
+    auto solver = std::find_if(solvers.begin(),solvers.end(),[&](const Solver& s){ return s.puzzle == puzzle; });
+    if(solver == solvers.end()){
+        return connection.respond("error","Unknown puzzle (" + puzzle + ")");
+    }
+    int part = aoc::to_part_number(part_name);
+
+    //Solve on the request pool, which limits the number of concurrent
+    //requests. This thread only waits.
+    Result result;
+    server.in_flight++;
+    auto done = std::make_shared<std::promise<void>>();
+    server.requests->submit([&,done](){
+        solve(*solver,part,path,payload,server.cache.get(),result);
+        done->set_value();
+    });
+    done->get_future().wait();
+    server.in_flight--;
+
+    auto end = std::chrono::steady_clock::now();
+    long long total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - received).count();
+    server.statistics.record(puzzle + "/" + part_name,total_ns,!result.error.empty());
+
+    if(!result.error.empty()){
+        return connection.respond("error",result.error);
+    }
+    std::string timings;
+    for(const auto& [name,ns] : result.ns){
+        timings += " " + name + "=" + std::to_string(ns);
+    }
+    timings += " total=" + std::to_string(total_ns);
+    if(result.cached){
+        timings += " cached=1";
+    }
+    return connection.respond("ok",result.output,timings);
+}
+
+//Answer the requests of a client, until it disconnects
+void handle_connection(Server& server, int fd){
+    Connection connection(fd);
+    std::string line;
+    while(!server.stopping && connection.read_line(line)){
+        auto received = std::chrono::steady_clock::now();
+        std::istringstream request(line);
+        std::string command;
+        request >> command;
+        bool connected = true;
+        try{
+            if(command == "solve"){
+                connected = handle_solve(server,connection,request,received);
+            }else if(command == "stats"){
+                connected = connection.respond("ok",server.statistics.report(server.in_flight));
+            }else if(command == "list"){
+                std::string names;
+                for(const auto& solver : solvers){
+                    names += solver.puzzle + "\n";
+                }
+                connected = connection.respond("ok",names);
+            }else if(command == "shutdown"){
+                connection.respond("ok","");
+                server.stop();
+                break;
+            }else{
+                connected = connection.respond("error","Unknown request (" + command + ")");
+            }
+        }catch(const std::exception& e){
+            connected = connection.respond("error",e.what());
+        }
+        if(!connected){
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(server.mutex);
+    server.clients.erase(fd);
+    ::close(fd);
+    server.closed.notify_all();
+}
+
+//Client mode: connect to the server (waiting up to 10 seconds for it to
+//start listening), send the requests in order on a single connection, and
+//print every response (status line and output). Returns 1 if any request
+//was answered with an error.
+int run_client(const Settings& settings, const sockaddr_un& address){
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    int fd;
+    while(true){
+        fd = ::socket(AF_UNIX,SOCK_STREAM,0);
+        if(fd < 0){
+            throw std::runtime_error(std::string("Could not create a socket: ") + std::strerror(errno));
+        }
+        if(::connect(fd,reinterpret_cast<const sockaddr*>(&address),sizeof(address)) == 0){
+            break;
+        }
+        int error = errno;
+        ::close(fd);
+        bool starting = (error == ENOENT || error == ECONNREFUSED);
+        if(!starting || std::chrono::steady_clock::now() > deadline){
+            throw std::runtime_error("Could not connect to " + settings.socket_path + ": " + std::strerror(error));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    Connection connection(fd);
+    bool failed = false;
+    for(const std::string& request : settings.requests){
+        std::string status, output, result;
+        size_t n_bytes = 0;
+        if(!connection.write(request + "\n") || !connection.read_line(status)){
+            throw std::runtime_error("Connection lost while sending: " + request);
+        }
+        std::istringstream(status) >> result >> n_bytes;
+        if(!connection.read_bytes(n_bytes,output)){
+            throw std::runtime_error("Connection lost while receiving the response to: " + request);
+        }
+        std::cout << status << std::endl << output << std::flush;
+        failed = failed || (result != "ok");
+    }
+    ::close(fd);
+    return failed ? 1 : 0;
+}
+
+void print_usage(){
+    std::cout << "Usage: ./aoc_served [--socket <path>] [--threads N] [--cache]" << std::endl;
+    std::cout << "       ./aoc_served [--socket <path>] --send <request> [--send <request> ...]" << std::endl;
+    std::cout << "Keeps all puzzles loaded, and solves them on request. Requests are sent to a" << std::endl;
+    std::cout << "Unix domain socket (default: /tmp/aoc_served.sock), and are solved concurrently" << std::endl;
+    std::cout << "by N threads (default: number of hardware threads), which the puzzles use for" << std::endl;
+    std::cout << "their parallel loops as well (on a separate pool). With --cache, results are" << std::endl;
+    std::cout << "stored in (and returned from) the on-disk result cache. See served/main.cpp for" << std::endl;
+    std::cout << "the protocol." << std::endl;
+    std::cout << "With --send, it connects to a running server instead, sends the requests, and" << std::endl;
+    std::cout << "prints the responses (the exit code is 1 if any request failed)." << std::endl;
+}
+
+//Solver daemon
+int main(int argc, char *argv[]){
+
+    //Parse the program arguments
+    Server server;
+    Settings& settings = server.settings;
+    for(int i = 1; i<argc; i++){
+        std::string arg = argv[i];
+        if((arg == "--socket" || arg == "--threads" || arg == "--send") && i+1 >= argc){
+            throw std::runtime_error("Missing value for " + arg);
+        }
+        if(arg == "--socket"){
+            settings.socket_path = argv[++i];
+        }else if(arg == "--threads"){
+            settings.n_threads = std::max(1,std::stoi(argv[++i]));
+        }else if(arg == "--cache"){
+            settings.cache = true;
+        }else if(arg == "--send"){
+            settings.requests.push_back(argv[++i]);
+        }else if(arg == "--help" || arg == "-h"){
+            print_usage();
+            return 0;
+        }else{
+            throw std::runtime_error("Unknown argument (" + arg + ")");
+        }
+    }
+
+    //Clients that disconnect early should not kill the server
+    ::signal(SIGPIPE,SIG_IGN);
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(settings.socket_path.size() >= sizeof(address.sun_path)){
+        throw std::runtime_error("Socket path too long: " + settings.socket_path);
+    }
+    std::strcpy(address.sun_path,settings.socket_path.c_str());
+
+    if(!settings.requests.empty()){
+        return run_client(settings,address);
+    }
+
+    //Remove the socket of a previous server, but nothing else
+    struct stat file_stat;
+    if(::stat(settings.socket_path.c_str(),&file_stat) == 0){
+        if(!S_ISSOCK(file_stat.st_mode)){
+            throw std::runtime_error(settings.socket_path + " exists, and is not a socket");
+        }
+        ::unlink(settings.socket_path.c_str());
+    }
+
+    //Only the user running the server may connect: the socket is created
+    //without permissions for others (umask), and made 0600 to be sure
+    server.listen_fd = ::socket(AF_UNIX,SOCK_STREAM,0);
+    mode_t previous_umask = ::umask(0177);
+    bool bound = server.listen_fd >= 0 &&
+                 ::bind(server.listen_fd,reinterpret_cast<sockaddr*>(&address),sizeof(address)) == 0;
+    ::umask(previous_umask);
+    if(!bound ||
+       ::chmod(settings.socket_path.c_str(),S_IRUSR | S_IWUSR) != 0 ||
+       ::listen(server.listen_fd,64) != 0){
+        throw std::runtime_error("Could not listen on " + settings.socket_path + ": " + std::strerror(errno));
+    }
+
+    if(settings.cache){
+        server.cache = std::make_unique<aoc::ResultCache>(aoc::ResultCache::default_directory(),aoc::ResultCache::default_size());
+    }
+
+    //Both the requests and the parallel loops within the puzzles use N threads
+    server.requests = std::make_unique<aoc::TaskPool>(settings.n_threads);
+    aoc::TaskPool::set_global_threads(settings.n_threads);
+    std::cerr << "aoc_served: " << solvers.size() << " puzzles, " << server.requests->size()
+              << " threads, listening on " << settings.socket_path << std::endl;
+
+    //Every connection gets its own thread, which only reads the requests and
+    //waits for the results (the solving happens on the request pool)
+    while(!server.stopping){
+        int fd = ::accept(server.listen_fd,nullptr,nullptr);
+        if(fd < 0){
+            if(errno == EINTR || errno == ECONNABORTED){
+                continue;
+            }
+            break;
+        }
+        std::lock_guard<std::mutex> lock(server.mutex);
+        if(server.stopping){
+            ::close(fd);
+            break;
+        }
+        server.clients.insert(fd);
+        std::thread(handle_connection,std::ref(server),fd).detach();
+    }
+
+    //Wait for the requests that are still being solved
+    server.stop();
+    {
+        std::unique_lock<std::mutex> lock(server.mutex);
+        server.closed.wait(lock,[&](){ return server.clients.empty(); });
+    }
+    ::close(server.listen_fd);
+    ::unlink(settings.socket_path.c_str());
+    std::cerr << "aoc_served: stopped" << std::endl;
+
+    return 0;
+}
\ No newline at end of file
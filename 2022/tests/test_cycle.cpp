@@ -0,0 +1,108 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "aoc_cycle.hpp"
+
+/*
+    Unit test of aoc::CycleDetector: sequences with a known tail and period
+    are run through both modes, which must agree with each other, and with
+    the values of a direct simulation.
+*/
+
+void check(bool condition, const std::string& message){
+    if(!condition){
+        throw std::runtime_error(message);
+    }
+}
+
+//The test sequence: tail steps with unique states, followed by a cycle of
+//period states. The value grows by an amount that depends on the state.
+struct Sequence{
+    long long tail;
+    long long period;
+
+    long long state(long long step) const{
+        return (step < tail) ? -1 - step : (step - tail) % period;
+    }
+
+    //The value at every step up to (and including) last_step
+    std::vector<long long> values(long long last_step) const{
+        std::vector<long long> result;
+        long long value = 0;
+        for(long long step = 0; step<=last_step; step++){
+            value += state(step) % 7 + 3;
+            result.push_back(value);
+        }
+        return result;
+    }
+};
+
+//Add steps of the sequence until the detector finds the cycle
+void detect(aoc::CycleDetector<long long>& cycle, const Sequence& sequence){
+    const std::vector<long long> values = sequence.values(10*(sequence.tail + sequence.period) + 10);
+    for(long long step = 0; !cycle.found(); step++){
+        check(step < static_cast<long long>(values.size()), "No cycle found");
+        cycle.add(sequence.state(step),values[step]);
+    }
+}
+
+void test_sequence(const Sequence& sequence){
+    const std::string name = "tail " + std::to_string(sequence.tail) + ", period " + std::to_string(sequence.period) + ": ";
+    aoc::CycleDetector<long long> table(aoc::CycleMode::table);
+    aoc::CycleDetector<long long> brent(aoc::CycleMode::brent);
+    detect(table,sequence);
+    detect(brent,sequence);
+
+    check(table.cycle_start() == sequence.tail, name + "table mode starts the cycle at " + std::to_string(table.cycle_start()));
+    check(brent.cycle_start() >= sequence.tail, name + "brent mode starts the cycle in the tail");
+    check(table.period() == sequence.period, name + "table mode finds period " + std::to_string(table.period()));
+    check(brent.period() == sequence.period, name + "brent mode finds period " + std::to_string(brent.period()));
+    check(table.delta() == brent.delta(), name + "the modes disagree on delta()");
+
+    //Values that can still be simulated
+    const long long last_step = 20*(sequence.tail + sequence.period) + 100;
+    const std::vector<long long> values = sequence.values(last_step);
+    for(long long step = brent.cycle_start(); step<=last_step; step++){
+        check(table.value_at(step) == values[step], name + "table mode, wrong value at step " + std::to_string(step));
+        check(brent.value_at(step) == values[step], name + "brent mode, wrong value at step " + std::to_string(step));
+    }
+
+    //Values far beyond that
+    for(long long step = 1000000000000LL; step<1000000000000LL + 2*sequence.period; step++){
+        check(table.value_at(step) == brent.value_at(step), name + "the modes disagree at step " + std::to_string(step));
+    }
+
+    //Brent mode only keeps the values since its saved state (the start of
+    //the cycle it found)
+    auto throws = [](const auto& f){
+        try{
+            f();
+        }catch(const std::runtime_error&){
+            return true;
+        }
+        return false;
+    };
+    check(throws([&](){ table.value_at(-1); }), name + "table mode accepts a negative step");
+    check(throws([&](){ brent.value_at(-1); }), name + "brent mode accepts a negative step");
+    if(brent.cycle_start() > 0){
+        check(throws([&](){ brent.value_at(brent.cycle_start() - 1); }), name + "brent mode returns a value that is not kept");
+        check(table.value_at(brent.cycle_start() - 1) == values[brent.cycle_start() - 1], name + "table mode, wrong value before the cycle");
+    }
+}
+
+int main(){
+    const std::vector<Sequence> sequences = {
+        {0,1}, {0,5}, {1,1}, {5,3}, {3,64}, {37,100}, {1000,17}, {129,1000}
+    };
+    try{
+        for(const Sequence& sequence : sequences){
+            test_sequence(sequence);
+        }
+    }catch(const std::exception& e){
+        std::cerr << "FAILED: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "All " << sequences.size() << " sequences passed" << std::endl;
+    return 0;
+}